@@ -0,0 +1,51 @@
+#include "AllocationCounter.h"
+
+#ifdef GA_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>  // std::malloc, std::aligned_alloc, std::free
+#include <new>
+
+namespace {
+    std::atomic<std::size_t> num_allocations{0};
+
+    void* counted_alloc(std::size_t size) {
+        num_allocations.fetch_add(1, std::memory_order_relaxed);
+        if (void* ptr = std::malloc(size ? size : 1)) {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+
+    void* counted_aligned_alloc(std::size_t size, std::align_val_t alignment) {
+        num_allocations.fetch_add(1, std::memory_order_relaxed);
+        const auto align = static_cast<std::size_t>(alignment);
+        // aligned_alloc requires the size to be a multiple of the alignment
+        const std::size_t rounded = ((size ? size : 1) + align - 1) / align * align;
+        if (void* ptr = std::aligned_alloc(align, rounded)) {
+            return ptr;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+std::size_t alloc_counter::count() noexcept {
+    return num_allocations.load(std::memory_order_relaxed);
+}
+
+// Replacements for the global allocation functions. The array, sized and nothrow forms default to calling these.
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return counted_aligned_alloc(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return counted_aligned_alloc(size, alignment); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef PROJECT_ALLOCATIONCOUNTER_H
+#define PROJECT_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+// Heap allocation counter for debug builds. When NDEBUG is not defined AllocationCounter.cpp replaces the global
+// operator new/delete with versions that count every allocation, and GA_COUNT_ALLOCATIONS is defined so callers
+// (e.g. GA::loop_allocations) can report how many allocations a piece of code made.
+// Release builds keep the standard allocation functions and none of this is compiled in.
+#ifndef NDEBUG
+#define GA_COUNT_ALLOCATIONS 1
+
+namespace alloc_counter {
+    // Total number of allocations made through the global operator new since program start - all threads.
+    [[nodiscard]] std::size_t count() noexcept;
+}
+#endif
+
+#endif //PROJECT_ALLOCATIONCOUNTER_H
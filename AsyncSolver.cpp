@@ -0,0 +1,135 @@
+#include <stdexcept>    // std::invalid_argument
+#include <utility>      // std::move
+
+#include "AsyncSolver.h"
+
+using std::invalid_argument;    // If a solve is already running or the GA has no population
+
+AsyncSolver::AsyncSolver(GA& ga) noexcept :
+    ga_(&ga)
+{}
+
+AsyncSolver::~AsyncSolver() {
+    cancel();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void AsyncSolver::start(std::size_t num_generations, GA::StopCriteria criteria) {
+    if (running_.load(std::memory_order_acquire)) {
+        throw invalid_argument("A solve is already running.");
+    }
+    if (ga_->words_per_chromosome() == 0) {
+        throw invalid_argument("The GA parameters have not been set.");
+    }
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    // Clear the previous solve's solution, through the seqlock as readers may still be polling
+    const std::size_t num_words = ga_->words_per_chromosome();
+    if (num_words != num_words_) {
+        words_ = std::make_unique<std::atomic<packed::Word>[]>(num_words);
+        num_words_ = num_words;
+        final_genes_.resize(num_words);
+    }
+    num_genes_ = ga_->get_best_packed().num_genes();
+    const auto sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    best_cost_.store(0, std::memory_order_relaxed);
+    generation_.store(0, std::memory_order_relaxed);
+    for (std::size_t word = 0; word < num_words_; ++word) {
+        words_[word].store(0, std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+
+    published_ = false;
+    observer_ = user_observer_;
+    cancel_.store(false, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = false;
+    }
+    running_.store(true, std::memory_order_release);
+    worker_ = std::thread(&AsyncSolver::run_, this, num_generations, std::move(criteria));
+}
+
+GA::StopReason AsyncSolver::wait() {
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    return ga_->get_stop_reason();
+}
+
+bool AsyncSolver::wait_until(std::chrono::steady_clock::time_point deadline) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return finished_cv_.wait_until(lock, deadline, [this]() { return finished_; });
+}
+
+// Retries until the copy was made between two publishes - the sequence is the same even number before and after
+void AsyncSolver::snapshot(Snapshot& snapshot) const {
+    if (snapshot.chromosome.num_genes() != num_genes_) {
+        snapshot.chromosome = PackedChromosome(num_genes_);
+    }
+    auto* words = snapshot.chromosome.data();
+    for (;;) {
+        const auto before = sequence_.load(std::memory_order_acquire);
+        if (before % 2 == 0) {
+            snapshot.best_cost = best_cost_.load(std::memory_order_relaxed);
+            snapshot.generation = generation_.load(std::memory_order_relaxed);
+            for (std::size_t word = 0; word < num_words_; ++word) {
+                words[word] = words_[word].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                return;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+void AsyncSolver::on_progress(std::size_t generation, std::size_t best_cost, PackedView best) noexcept {
+    if (published_ && best_cost <= best_cost_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    publish_(generation, best_cost, best);
+    if (observer_) {
+        observer_->on_progress(generation, best_cost, best);
+    }
+}
+
+void AsyncSolver::publish_(std::size_t generation, std::size_t best_cost, PackedView best) noexcept {
+    const auto sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    best_cost_.store(best_cost, std::memory_order_relaxed);
+    generation_.store(generation, std::memory_order_relaxed);
+    for (std::size_t word = 0; word < num_words_; ++word) {
+        words_[word].store(best.words()[word], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+    published_ = true;
+}
+
+// The GA records a generation's best cost before breeding from it, so when every generation runs the final
+// population was never recorded - it is published here, as final_population, if it improved on the last record
+void AsyncSolver::run_(std::size_t num_generations, GA::StopCriteria criteria) noexcept {
+    criteria.cancel = &cancel_;
+    ga_->set_stop_criteria(criteria);
+    ga_->set_progress_observer(this);
+    ga_->new_population(num_generations);
+    ga_->set_progress_observer(nullptr);
+    criteria.cancel = nullptr;
+    ga_->set_stop_criteria(criteria);
+    std::size_t best_cost = 0;
+    ga_->export_elites(1, final_genes_.data(), &best_cost);
+    on_progress(final_population, best_cost, PackedView{final_genes_.data(), num_genes_});
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_ = true;
+    }
+    running_.store(false, std::memory_order_release);
+    finished_cv_.notify_all();
+}
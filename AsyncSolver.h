@@ -0,0 +1,99 @@
+#ifndef PROJECT_ASYNCSOLVER_H
+#define PROJECT_ASYNCSOLVER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "GA.h"
+
+// Anytime front end for a GA: new_population runs on a background worker while other threads poll the best solution
+// found so far, cancel the run or wait for it with a timeout. The best cost and chromosome are published through a
+// seqlock, so the worker never waits for a reader - publishing is a few atomic stores, made only when the best cost
+// improves - and readers retry the copy if it raced with a publish. Improvements can also be streamed to a
+// ProgressObserver on the worker thread.
+// The GA is not owned. It must have its CF and parameters set before start and must not be touched by anyone else
+// while a solve runs.
+class AsyncSolver : private ProgressObserver {
+public:
+    // A copy of the best solution published so far
+    struct Snapshot {
+        std::size_t best_cost = 0;
+        std::size_t generation = 0;     // Index into GA::get_best_costs() of the generation it was first seen in, or
+                                        // ProgressObserver::final_population if only the final population had it
+        PackedChromosome chromosome;
+    };
+
+    explicit AsyncSolver(GA& ga) noexcept;
+
+    // Cancels a running solve and waits for the worker
+    ~AsyncSolver() override;
+
+    // Sets the observer that receives every improvement of the best cost, on the worker thread. It is not owned and
+    // nullptr (the default) turns it off. Takes effect at the next start.
+    void set_observer(ProgressObserver* observer) noexcept { user_observer_ = observer; }
+
+    // Starts new_population(num_generations) on the worker with the given stop criteria - their cancel flag is
+    // replaced by the solver's own, so use cancel() instead. Use criteria.deadline to end the solve at a fixed time.
+    // Will throw if a solve is already running or the GA has no population.
+    void start(std::size_t num_generations, GA::StopCriteria criteria = {});
+
+    // Asks the worker to stop before its next generation. Does not wait.
+    void cancel() noexcept { cancel_.store(true, std::memory_order_relaxed); }
+
+    // Waits until the solve is done and returns why it stopped
+    GA::StopReason wait();
+
+    // Waits until the solve is done or the time has come. Returns true if it is done.
+    bool wait_until(std::chrono::steady_clock::time_point deadline);
+    template <typename Rep, typename Period>
+    bool wait_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return wait_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    // True unless a solve has been started and has not finished yet
+    [[nodiscard]] bool done() const noexcept { return !running_.load(std::memory_order_acquire); }
+
+    // Lock free reads of the best solution so far, safe from any number of threads while the worker runs. best_cost
+    // may be ahead of a concurrent snapshot. snapshot only allocates the first time the given chromosome is sized;
+    // it must not be called concurrently with start.
+    [[nodiscard]] std::size_t best_cost() const noexcept { return best_cost_.load(std::memory_order_relaxed); }
+    void snapshot(Snapshot& snapshot) const;
+
+    AsyncSolver &operator=(const AsyncSolver &) = delete;
+    AsyncSolver(const AsyncSolver &) = delete;
+private:
+    // Publishes improvements and forwards them to the user's observer
+    void on_progress(std::size_t generation, std::size_t best_cost, PackedView best) noexcept override;
+
+    // Writes the solution into the seqlock
+    void publish_(std::size_t generation, std::size_t best_cost, PackedView best) noexcept;
+
+    // Body of the worker thread
+    void run_(std::size_t num_generations, GA::StopCriteria criteria) noexcept;
+
+    GA* ga_;
+    ProgressObserver* user_observer_ = nullptr;
+    ProgressObserver* observer_ = nullptr;  // The user's observer for the current solve
+    std::thread worker_;
+    std::atomic<bool> cancel_{false};
+    std::atomic<bool> running_{false};
+    std::mutex mutex_;                      // Guards finished_ for the waits
+    std::condition_variable finished_cv_;
+    bool finished_ = true;
+
+    // The seqlock: sequence_ is odd while the worker writes the fields below it
+    std::atomic<std::size_t> sequence_{0};
+    std::atomic<std::size_t> best_cost_{0};
+    std::atomic<std::size_t> generation_{0};
+    std::unique_ptr<std::atomic<packed::Word>[]> words_;
+    std::size_t num_words_ = 0;
+    std::size_t num_genes_ = 0;
+    std::vector<packed::Word> final_genes_; // Worker only: the best chromosome once new_population returns
+    bool published_ = false;                // Worker only: whether this solve has published yet
+};
+#endif //PROJECT_ASYNCSOLVER_H
@@ -0,0 +1,1314 @@
+#ifndef PROJECT_BASICGA_H
+#define PROJECT_BASICGA_H
+
+#include <algorithm>        // std::sort, std::copy_n, heap algorithms
+#include <array>            // Telemetry chunk times
+#include <atomic>           // Parallel repair flag, telemetry evaluation count
+#include <chrono>           // Stop criteria time budget
+#include <cstdio>           // std::rename, std::remove - checkpoints
+#include <cstring>          // std::memcpy, std::memcmp - checkpoints
+#include <fstream>          // File I/O - export_results
+#include <iterator>         // File I/O - export_results
+#include <memory>           // Thread pool
+#include <numeric>          // std::iota, std::partial_sum
+#include <optional>         // Stop criteria target cost
+#include <random>           // Rng seeding & steady state flip counts
+#include <stdexcept>        // std::invalid_argument
+#include <string>           // For export filename
+#include <thread>           // std::thread::hardware_concurrency
+#include <type_traits>      // Policy dispatch
+#include <utility>          // std::move
+
+#include "AllocationCounter.h"
+#include "BinaryCostFunction.h"
+#include "Checkpoint.h"
+#include "FitnessCache.h"
+#include "GAPolicies.h"
+#include "PopulationArena.h"
+#include "ProgressObserver.h"
+#include "Random.h"
+#include "Repair.h"
+#include "Selection.h"
+#include "Telemetry.h"
+#include "ThreadPool.h"
+
+// The run-time interface of a GA, implemented by every BasicGA instantiation. GA (see GA.h) holds one of these and
+// forwards to it; the members are documented there.
+class GAInterface {
+public:
+    using Chromosome = BinaryCostFunction::Chromosome;
+
+    // Criteria that end new_population before all its generations have run. Every criterion is off by default.
+    struct StopCriteria {
+        std::size_t stall_generations = 0;          // Stop after this many generations without a better best cost
+        std::optional<std::size_t> target_cost;     // Stop once the best cost reaches this (e.g. a known optimum or bound)
+        std::chrono::milliseconds time_budget{0};   // Stop once a call has run for this long
+        std::optional<std::chrono::steady_clock::time_point> deadline;  // Stop once this time has passed
+        double min_diversity = 0.;                  // Stop once get_diversity() drops below this
+        const std::atomic<bool>* cancel = nullptr;  // Stop once this flag (set by another thread) is true
+    };
+
+    // Why the last call to new_population returned. TimeBudget covers both the budget and the deadline.
+    enum class StopReason { Generations, Stalled, TargetReached, TimeBudget, Converged, Cancelled };
+
+    enum class Mode {
+        Generational,   // Every non-elite chromosome is replaced each generation
+        SteadyState     // Each step replaces the worst chromosomes with a few children
+    };
+
+    // Destructor is virtual in the abstract base class
+    virtual ~GAInterface() = default;
+
+    virtual void set_seed(std::size_t seed) noexcept = 0;
+    virtual void set_cf(const BinaryCostFunction* cf) = 0;
+    virtual void set_num_threads(std::size_t num_threads) = 0;
+    virtual void set_repair(const RepairOperator* repair) = 0;
+    virtual void set_selection(const SelectionPolicy* selection) = 0;
+    virtual void set_fitness_cache(FitnessCache* cache) noexcept = 0;
+    virtual void set_progress_observer(ProgressObserver* observer) noexcept = 0;
+    virtual void set_mode(Mode mode, std::size_t num_replacements) = 0;
+    virtual void set_stop_criteria(const StopCriteria& criteria) noexcept = 0;
+    [[nodiscard]] virtual StopReason get_stop_reason() const noexcept = 0;
+    [[nodiscard]] virtual double get_diversity() const noexcept = 0;
+
+    virtual void set_warm_start(const packed::Word* genes, std::size_t num_chromosomes) = 0;
+    virtual void set_parameters(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate) = 0;
+    virtual void new_population(std::size_t num_generations) noexcept = 0;
+    virtual void save_checkpoint(const std::string& filename) const = 0;
+    virtual void load_checkpoint(const std::string& filename) = 0;
+
+    [[nodiscard]] virtual std::size_t get_best_cost() const noexcept = 0;
+    [[nodiscard]] virtual Chromosome get_best_chromosome() const noexcept = 0;
+    [[nodiscard]] virtual PackedView get_best_packed() const noexcept = 0;
+    [[nodiscard]] virtual std::size_t words_per_chromosome() const noexcept = 0;
+    virtual void export_elites(std::size_t num_chromosomes, packed::Word* genes, std::size_t* costs) const noexcept = 0;
+    virtual void import_migrants(const packed::Word* genes, std::size_t num_chromosomes, const std::size_t* costs) noexcept = 0;
+    [[nodiscard]] virtual const std::vector<std::size_t>& get_best_costs() const noexcept = 0;
+    [[nodiscard]] virtual std::size_t get_solution_generation() const noexcept = 0;
+
+#ifdef GA_TELEMETRY
+    virtual void set_telemetry_observer(TelemetryObserver* observer) noexcept = 0;
+    virtual void set_diversity_interval(std::size_t interval) noexcept = 0;
+    [[nodiscard]] virtual const TelemetryRing& get_telemetry() const noexcept = 0;
+#endif
+
+#ifdef GA_COUNT_ALLOCATIONS
+    [[nodiscard]] virtual std::size_t loop_allocations() const noexcept = 0;
+#endif
+
+    virtual void prep_outfile(const std::string& filename, std::size_t num_gens, std::size_t num_runs) const = 0;
+    virtual void export_results(const std::string& filename) const = 0;
+
+    virtual std::ostream& print(std::ostream& os) const = 0;
+    friend std::ostream &operator<<(std::ostream& os, const GAInterface& ga) { return ga.print(os); }
+};
+
+// The GA with its operators chosen at compile time (see GAPolicies.h for what a policy provides):
+//  CostFn      The cost function type. set_cf only accepts cost functions of this type and the generation loop calls
+//              it without virtual dispatch; BinaryCostFunction accepts any cost function through virtual calls.
+//  Selection   Parent selection of the generational loop. The tournament size given to set_parameters applies to
+//              TournamentSelection and DynamicSelection; other policies keep the parameters they were built with.
+//  Crossover   SinglePointCrossover, UniformCrossover, or either of them wrapped in AllowClones.
+//  Mutation    GeometricMutation or UniformCountMutation - the generational loop's mutation. Steady state children
+//              are always mutated by flip count.
+//  Repair      Applied to unfeasible chromosomes.
+// set_selection and set_repair only work with the Dynamic* policies and throw otherwise. The policy objects are
+// copied into the GA and must be safe to use from several threads at once (their calls are const).
+// The defaults reproduce the run-time configurable GA (DefaultGA below), which GA uses unless given another engine.
+// Chromosomes are stored bit-packed (64 genes per word) so crossover is done as masked word copies and mutation as
+// an XOR of a bit mask. The unpacked Chromosome type is still used at the interface.
+// The population is a contiguous arena indexed by chromosome number. Each generation the elites are copied into the
+// front of a second arena and the children are written straight into the remaining slots, then the arenas are swapped.
+// After set_parameters the generation loop makes no heap allocations (provided the cost function's eval does not).
+// In steady state mode the ranking is kept in a heap so a step costs O(log P) rather than a full sort.
+// Fitness evaluation, repair and offspring production can be spread over a thread pool (see set_num_threads). Children
+// are produced in fixed chunks that each own an rng stream derived from the GA seed, so a seeded GA gives the same
+// results for any number of threads.
+// Cost functions that support running totals (BinaryCostFunction::supports_totals) are evaluated incrementally:
+// each chromosome's totals are updated in O(1) per mutation flip and in O(changed range) per crossover, and repair
+// works on the totals directly instead of calling eval after every gene it changes.
+template <typename CostFn = BinaryCostFunction, typename Selection = DynamicSelection,
+          typename Crossover = SinglePointCrossover, typename Mutation = GeometricMutation,
+          typename Repair = DynamicRepair>
+class BasicGA final : public GAInterface {
+public:
+    using Gene = BinaryCostFunction::Gene;
+    using Population = PopulationArena;
+    using Engine = Xoshiro256;
+    using Totals = BinaryCostFunction::Totals;
+
+    static_assert(std::is_base_of_v<BinaryCostFunction, CostFn>, "The cost function must be a BinaryCostFunction.");
+
+    // Default constructor that uses random seed for the random number generator
+    BasicGA() = default;
+
+    // Constructor that takes in a seed to allow for deterministic results, and optionally the policy objects
+    explicit BasicGA(std::size_t seed, Selection selection = Selection(), Crossover crossover = Crossover(),
+                     Mutation mutation = Mutation(), Repair repair = Repair());
+
+    void set_seed(std::size_t seed) noexcept override { eng_.seed(seed); }
+    void set_cf(const BinaryCostFunction* cf) override;
+    void set_num_threads(std::size_t num_threads) override;
+    void set_repair(const RepairOperator* repair) override;
+    void set_selection(const SelectionPolicy* selection) override;
+    void set_fitness_cache(FitnessCache* cache) noexcept override { cache_ = cache; }
+    void set_progress_observer(ProgressObserver* observer) noexcept override { observer_ = observer; }
+    void set_mode(Mode mode, std::size_t num_replacements) override;
+    void set_stop_criteria(const StopCriteria& criteria) noexcept override { stop_criteria_ = criteria; }
+    [[nodiscard]] StopReason get_stop_reason() const noexcept override { return stop_reason_; }
+    [[nodiscard]] double get_diversity() const noexcept override;
+
+    void set_warm_start(const packed::Word* genes, std::size_t num_chromosomes) override;
+    void set_parameters(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate) override;
+    void new_population(std::size_t num_generations) noexcept override;
+    void save_checkpoint(const std::string& filename) const override;
+    void load_checkpoint(const std::string& filename) override;
+
+    [[nodiscard]] std::size_t get_best_cost() const noexcept override { return best_costs_.back(); }
+    [[nodiscard]] Chromosome get_best_chromosome() const noexcept override { return BinaryCostFunction::unpack(population_[ranks_[0]]); }
+    [[nodiscard]] PackedView get_best_packed() const noexcept override { return population_[ranks_[0]]; }
+    [[nodiscard]] std::size_t words_per_chromosome() const noexcept override { return population_.words_per_chromosome(); }
+    void export_elites(std::size_t num_chromosomes, packed::Word* genes, std::size_t* costs) const noexcept override;
+    void import_migrants(const packed::Word* genes, std::size_t num_chromosomes, const std::size_t* costs) noexcept override;
+    [[nodiscard]] const std::vector<std::size_t>& get_best_costs() const noexcept override { return best_costs_; }
+    [[nodiscard]] std::size_t get_solution_generation() const noexcept override;
+
+#ifdef GA_TELEMETRY
+    void set_telemetry_observer(TelemetryObserver* observer) noexcept override { telemetry_.set_observer(observer); }
+    void set_diversity_interval(std::size_t interval) noexcept override { diversity_interval_ = interval; }
+    [[nodiscard]] const TelemetryRing& get_telemetry() const noexcept override { return telemetry_; }
+#endif
+
+#ifdef GA_COUNT_ALLOCATIONS
+    [[nodiscard]] std::size_t loop_allocations() const noexcept override { return loop_allocations_; }
+#endif
+
+    void prep_outfile(const std::string& filename, std::size_t num_gens, std::size_t num_runs) const override;
+    void export_results(const std::string& filename) const override;
+
+    std::ostream& print(std::ostream& os) const override;
+
+    BasicGA &operator=(const BasicGA &) = delete;
+    BasicGA(const BasicGA &) = delete;
+private:
+    // The benchmarks (bench/GABench.cpp) time the generation loop operators individually
+    friend struct GABenchAccess;
+
+    std::size_t chromosome_size_ = 0;
+    const CostFn* cf_ = nullptr;
+    bool use_totals_ = false;   // True if cf_ supports delta evaluation through running totals
+
+    FitnessCache* cache_ = nullptr;
+    ProgressObserver* observer_ = nullptr;
+
+    std::vector<packed::Word> warm_start_;  // Chromosomes placed in the first slots of every new population
+    std::size_t num_warm_start_ = 0;
+
+    Selection selection_;
+    Crossover crossover_;
+    Mutation mutation_;
+    Repair repair_op_;
+    // Steady state steps do not keep a full ranking, so they always use tournament selection
+    TournamentSelection steady_selection_;
+    // Redraws of a second parent equal to the first before falling back to a uniformly drawn different chromosome
+    static constexpr std::size_t max_redraws_ = 8;
+
+    // Children are produced in chunks of at least this many chromosomes. Each chunk owns an rng stream.
+    static constexpr std::size_t min_chunk_size_ = 8;
+    // Upper bound on the number of offspring chunks (and rng streams) regardless of the population size
+    static constexpr std::size_t max_chunks_ = 64;
+
+    StopCriteria stop_criteria_;
+    StopReason stop_reason_ = StopReason::Generations;
+    std::chrono::steady_clock::time_point start_time_;  // Start of the current new_population call
+    std::size_t stall_best_ = 0;                        // Best cost when the current stall began
+    std::size_t stall_count_ = 0;                       // Generations since the best cost last improved
+
+    Mode mode_ = Mode::Generational;
+    std::size_t num_replacements_ = 1;  // Children per steady state step
+
+    // GA parameters
+    std::size_t population_size_ = 0;
+    std::size_t num_elite_ = 0;
+    std::size_t tournament_size_ = 0;
+    std::size_t num_mutations_ = 0;
+    double mutation_probability_ = 0.;  // Per gene flip probability giving num_mutations_ flips on average
+
+    Population                  population_;        // The population of chromosomes and their costs/fitness'
+    Population                  next_population_;   // The generation being built - swapped with population_
+    std::vector<std::size_t>    ranks_;             // Stores the rank of each chromosome - rank[0] is best
+    std::vector<std::size_t>    best_costs_;        // Stores the highest fitness chromosome of each generation
+    std::vector<std::size_t>    heap_;              // Steady state: min-heap of chromosome numbers on cost (worst first)
+    std::vector<std::size_t>    misses_;            // Chromosome numbers the fitness cache had no cost for
+    std::vector<std::size_t>    parents_;           // Two parents per child, drawn in bulk for each offspring chunk
+    std::vector<std::size_t>    cumulative_;        // Running sums of the costs for selection policies that need them
+
+    std::unique_ptr<ThreadPool> pool_;          // Worker threads - null when running single threaded
+    std::vector<Engine>         streams_;       // One rng stream per offspring chunk, seeded from eng_
+    std::size_t                 chunk_size_ = 0;// Number of children produced per chunk
+
+#ifdef GA_COUNT_ALLOCATIONS
+    std::size_t loop_allocations_ = 0;  // Allocations made in the generation loop of the last new_population call
+#endif
+
+#ifdef GA_TELEMETRY
+    mutable std::atomic<std::size_t> num_evals_{0};     // Evaluations made through the cf_* calls below
+    std::optional<CountingCostFunction> counting_cf_;   // Wraps the cost function for the repair operator
+    TelemetryRing telemetry_;
+    GenerationTelemetry telemetry_record_;              // Record of the generation in progress
+    std::vector<std::array<std::uint64_t, 2>> chunk_ns_; // Selection and crossover nanoseconds of each offspring chunk
+    std::size_t diversity_interval_ = 1;
+    std::size_t evals_before_ = 0;                      // Evaluation count at the start of the generation
+#endif
+
+    // Cost function calls. Unless CostFn is abstract they name CostFn's functions directly, so they are not virtual
+    // and the inline ones (e.g. Knapsack's eval_totals) are inlined into the loops.
+    [[nodiscard]] std::size_t cf_eval_(PackedView chromosome) const noexcept {
+        count_evals_(1);
+        if constexpr (std::is_abstract_v<CostFn>) {
+            return cf_->eval(chromosome);
+        } else {
+            return cf_->CostFn::eval(chromosome);
+        }
+    }
+    void cf_eval_batch_(const packed::Word* genes, std::size_t num_chromosomes, std::size_t* costs) const noexcept {
+        count_evals_(num_chromosomes);
+        if constexpr (std::is_abstract_v<CostFn>) {
+            cf_->eval_batch(genes, population_.words_per_chromosome(), num_chromosomes, costs);
+        } else {
+            cf_->CostFn::eval_batch(genes, population_.words_per_chromosome(), num_chromosomes, costs);
+        }
+    }
+    [[nodiscard]] std::size_t cf_eval_totals_(const Totals& totals) const noexcept {
+        count_evals_(1);
+        if constexpr (std::is_abstract_v<CostFn>) {
+            return cf_->eval_totals(totals);
+        } else {
+            return cf_->CostFn::eval_totals(totals);
+        }
+    }
+    [[nodiscard]] Totals cf_totals_(PackedView chromosome, std::size_t first_gene, std::size_t last_gene) const noexcept {
+        if constexpr (std::is_abstract_v<CostFn>) {
+            return cf_->totals(chromosome, first_gene, last_gene);
+        } else {
+            return cf_->CostFn::totals(chromosome, first_gene, last_gene);
+        }
+    }
+    [[nodiscard]] Totals cf_gene_totals_(std::size_t gene) const noexcept {
+        if constexpr (std::is_abstract_v<CostFn>) {
+            return cf_->gene_totals(gene);
+        } else {
+            return cf_->CostFn::gene_totals(gene);
+        }
+    }
+
+    // The cost function handed to the repair operator - counts its evaluations in telemetry builds
+    [[nodiscard]] const BinaryCostFunction& repair_cf_() const noexcept {
+#ifdef GA_TELEMETRY
+        return *counting_cf_;
+#else
+        return *cf_;
+#endif
+    }
+
+    // Telemetry builds count every evaluation. No-ops otherwise.
+    void count_evals_([[maybe_unused]] std::size_t num) const noexcept {
+#ifdef GA_TELEMETRY
+        num_evals_.fetch_add(num, std::memory_order_relaxed);
+#endif
+    }
+#ifdef GA_TELEMETRY
+    [[nodiscard]] std::size_t total_evals_() const noexcept {
+        return num_evals_.load(std::memory_order_relaxed) + counting_cf_->num_evals();
+    }
+#endif
+
+    // Sizes the containers for the current parameters and seeds the offspring streams from eng_
+    void allocate_();
+
+    // Number of offspring chunks (and rng streams) for the given population parameters
+    [[nodiscard]] static std::size_t num_chunks_(std::size_t pop_size, std::size_t num_elite) noexcept;
+
+    // Initializes all the genes at random - uniform distribution of In's (1) and Out's (0) - except for the warm
+    // start chromosomes, and calculates their initial costs
+    void rand_init_() noexcept;
+
+    // Calculate the cost or fitness of each dirty chromosome in the population and clears the dirty flags.
+    // num_elite is used to specify elite chromosomes, which always occupy the first num_elite slots when this is
+    // called, so the chromosomes to evaluate are contiguous and runs of dirty ones go to the cost function as batches.
+    void calculate_costs_(std::size_t num_elite = 0) noexcept;
+
+    // The evaluation half of calculate_costs_ without the cache: evaluates and cleans the dirty chromosomes
+    void evaluate_dirty_(std::size_t num_elite) noexcept;
+
+    // calculate_costs_ through the fitness cache: a serial lookup pass over the dirty chromosomes, a parallel
+    // evaluation of the misses and a serial insert pass. Does not rank.
+    void cached_costs_(std::size_t num_elite) noexcept;
+
+    // Sets the cost of chromosome 'chromosome_no' to cost
+    // No error checking since this is only used internally
+    void set_cost_(std::size_t chromosome_no, std::size_t cost) { population_.cost(chromosome_no) = cost; }
+
+    // Return the costs/fitness' of a chromosome.
+    [[nodiscard]] std::size_t cost_(std::size_t chromosome_no) const noexcept { return population_.cost(chromosome_no); }
+
+    // Returns the chromosome number of the chromosome with the given rank
+    [[nodiscard]] std::size_t chromosome_at_rank_(std::size_t rank) const noexcept { return ranks_[rank]; }
+
+    // Stores the cost of the most fit chromosome - for output purposes
+    void store_best_cost_() noexcept {
+        best_costs_.push_back(cost_(ranks_[0]));
+        if (observer_) {
+            observer_->on_progress(best_costs_.size() - 1, best_costs_.back(), population_[ranks_[0]]);
+        }
+    }
+
+    // The population as seen by the selection policy
+    [[nodiscard]] SelectionView selection_view_() const noexcept;
+
+    // Computes the running cost sums if the selection policy needs them. Called once the population is ranked.
+    void prepare_selection_() noexcept;
+
+    // Replaces parent2 if it is a clone of parent1: up to max_redraws_ redraws from the policy, then a uniformly
+    // drawn different chromosome
+    template <typename Policy>
+    void avoid_clone_(const Policy& policy, const SelectionView& view, Engine& eng, std::size_t parent1,
+                      std::size_t& parent2) const noexcept;
+
+    // Crosses the 2 parent chromosomes with the given chromosome numbers and writes the child chromosome, a
+    // combination of the 2 parent chromosomes, into the given slot of the next population. A child identical to a
+    // parent inherits its cost and is left clean; any other child is marked dirty.
+    void cross_(std::size_t p1_chromosome_no, std::size_t p2_chromosome_no, std::size_t child_no, Engine& eng) noexcept;
+
+    // Marks the child dirty unless it is identical to one of its parents, in which case it takes the parent's cost
+    void inherit_cost_(std::size_t p1_chromosome_no, std::size_t p2_chromosome_no, std::size_t child_no) noexcept;
+
+    // Fills the next population slots of the given offspring chunk with children
+    void produce_chunk_(std::size_t chunk) noexcept;
+
+    // Performs on average num_mutations mutations at random throughout the population. A mutation simply toggles the
+    // targeted gene (In to Out, Out to In) and marks the chromosome dirty. Elite chromosomes (if specified) are
+    // immune to mutations.
+    void mutate_() noexcept;
+
+    // Start a telemetry record for the given generation and finish it once the generation is done. No-ops unless
+    // GA_TELEMETRY is defined.
+    void begin_telemetry_(std::size_t generation) noexcept;
+    void end_telemetry_() noexcept;
+
+    // Resets the stall and time budget tracking at the start of new_population
+    void start_stop_checks_() noexcept;
+
+    // Returns true and records the reason if a stop criterion is met by the current population. Diversity is only
+    // checked when check_diversity is true.
+    [[nodiscard]] bool should_stop_(bool check_diversity) noexcept;
+
+    // True once the time budget of the current call or the deadline has passed
+    [[nodiscard]] bool time_is_up_() const noexcept;
+
+    // Runs num_steps steady state steps. Children are bred into the front slots of next_population_, which serves
+    // as scratch space in this mode.
+    void steady_state_(std::size_t num_steps) noexcept;
+
+    // Flips on average mutations_per_child random genes of the child in the given next population slot
+    void mutate_child_(std::size_t child_no, double mutations_per_child) noexcept;
+
+    // Ensures all chromosomes correspond to feasible solutions.
+    // Assumes unfeasible chromosome have a cost of zero!
+    void repair_() noexcept;
+
+    // Sorts the rankings according to the current costs. Highest cost chromosome is rank 0 etc.
+    void rank_() noexcept;
+
+    // rng engine
+    Engine eng_{std::random_device{}()};
+
+    // Returns a random unsigned integer in the range [0, max] -> should use population_size_-1 & chromosome_size_-1
+    // where applicable as max argument
+    std::size_t rng_(std::size_t max) { return rng_(eng_, max); }
+    // Lemire bounded integers - no distribution object and no division on the fast path
+    static std::size_t rng_(Engine& eng, std::size_t max) { return static_cast<std::size_t>(rng::bounded(eng, max + 1)); }
+
+    // Returns 64 random bits - one random gene per bit
+    static packed::Word rng_word_(Engine& eng) { return eng(); }
+
+    // Runs fn(task) for every task in [0, num_tasks), on the thread pool if there is one
+    template <typename Fn>
+    void for_each_task_(std::size_t num_tasks, Fn&& fn) {
+        if (pool_) {
+            pool_->parallel_for(num_tasks, fn);
+        } else {
+            for (std::size_t task = 0; task < num_tasks; ++task) { fn(task); }
+        }
+    }
+
+    // Number of tasks to split a loop over the population into
+    [[nodiscard]] std::size_t num_tasks_() const noexcept { return pool_ ? pool_->size() * 4 : 1; }
+};
+
+// The run-time configurable GA: any cost function, selection policy and repair operator, single point crossover
+// without clones and geometric mutation. Instantiated once, in GA.cpp.
+using DefaultGA = BasicGA<>;
+extern template class BasicGA<>;
+
+// Member definitions. Every BasicGA member below is a template, so they live in the header with the class.
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::BasicGA(std::size_t seed, Selection selection,
+                                                                 Crossover crossover, Mutation mutation, Repair repair) :
+    selection_(std::move(selection)),
+    crossover_(std::move(crossover)),
+    mutation_(std::move(mutation)),
+    repair_op_(std::move(repair)),
+    eng_(seed)
+{}
+
+// Sets the cost function that the GA will use. The number of genes in each chromosome is automatically synced
+// to the incoming cost function. Will throw if the cost function has not been configured or is not a CostFn.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::set_cf(const BinaryCostFunction* cf) {
+    const auto* typed_cf = dynamic_cast<const CostFn*>(cf);
+    if (!typed_cf) {
+        throw std::invalid_argument("The cost function is not of the type the GA was built for.");
+    }
+    chromosome_size_ = cf->num_vars();
+    if (chromosome_size_ == 0) {
+        throw std::invalid_argument("The cost function has no configurations.");
+    }
+    cf_ = typed_cf;
+    warm_start_.clear();
+    num_warm_start_ = 0;
+#ifdef GA_TELEMETRY
+    // Evaluations made by the repair operator are counted by the wrapper
+    counting_cf_.emplace(*cf);
+#endif
+    use_totals_ = cf->supports_totals();
+    if (cache_) {
+        cache_->clear();
+    }
+}
+
+// Sets the number of threads used for evaluation, repair and offspring production.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::set_num_threads(std::size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    pool_ = (num_threads > 1) ? std::make_unique<ThreadPool>(num_threads) : nullptr;
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::set_repair([[maybe_unused]] const RepairOperator* repair) {
+    if constexpr (std::is_same_v<Repair, DynamicRepair>) {
+        repair_op_.set_operator(repair);
+    } else {
+        throw std::invalid_argument("The repair operator of this GA is fixed at compile time.");
+    }
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::set_selection([[maybe_unused]] const SelectionPolicy* selection) {
+    if constexpr (std::is_same_v<Selection, DynamicSelection>) {
+        selection_.set_policy(selection);
+    } else {
+        throw std::invalid_argument("The selection policy of this GA is fixed at compile time.");
+    }
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::set_mode(Mode mode, std::size_t num_replacements) {
+    if (num_replacements == 0) {
+        throw std::invalid_argument("A steady state step must replace at least one chromosome.");
+    }
+    mode_ = mode;
+    num_replacements_ = num_replacements;
+}
+
+// Sets the GA operator parameters and adjusts the containers accordingly - also randomly initializes the population
+// The mutation rate determines the number of genes that will be mutated each generation.
+// Will throw if the cost function has not been set of the parameters are invalid.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::set_parameters(std::size_t pop_size, std::size_t num_elite,
+                                                                             std::size_t t_size, double mutation_rate) {
+    if (!cf_) {
+        throw std::invalid_argument("The cost function has not been set.");
+    }
+    // Assuming the user will not use negative parameters as the interface indicates unsigned ints.
+    if (pop_size == 0 || num_elite >= pop_size || t_size == 0 || mutation_rate > 1. || mutation_rate < 0.) {
+        throw std::invalid_argument("One or more of the GA parameters is/are invalid.");
+    }
+    // Set parameters
+    population_size_ = pop_size;
+    num_elite_ = num_elite;
+    tournament_size_ = t_size;
+    num_mutations_ = static_cast<std::size_t>(mutation_rate * population_size_ * cf_->num_vars());
+    allocate_();
+    rand_init_();
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::allocate_() {
+    // The mutations are spread over the non-elite genes only
+    const auto num_mutable = static_cast<double>((population_size_ - num_elite_) * cf_->num_vars());
+    mutation_probability_ = std::min(1., static_cast<double>(num_mutations_) / num_mutable);
+    mutation_.set_probability(mutation_probability_);
+
+    // Adjust containers
+    ranks_.clear();
+    best_costs_.clear();
+    ranks_.resize(population_size_);
+    std::iota(std::begin(ranks_), std::end(ranks_), 0); // Fills rank from 0 (best) -> population_size - 1 (worst)
+    population_.resize(population_size_, chromosome_size_);
+    next_population_.resize(population_size_, chromosome_size_);
+    heap_.resize(population_size_);
+    misses_.resize(population_size_);
+    steady_selection_ = TournamentSelection(tournament_size_);
+    if constexpr (std::is_same_v<Selection, TournamentSelection>) {
+        selection_ = TournamentSelection(tournament_size_);
+    } else if constexpr (std::is_same_v<Selection, DynamicSelection>) {
+        selection_.set_tournament_size(tournament_size_);
+    }
+    parents_.resize(2 * (population_size_ - num_elite_));
+    cumulative_.resize(population_size_);
+    if (cache_) {
+        cache_->set_num_words(population_.words_per_chromosome());
+    }
+    // Split the children into chunks. The split only depends on the population parameters, never on the
+    // number of threads, and every chunk gets its own stream seeded from the main engine.
+    const std::size_t num_children = population_size_ - num_elite_;
+    chunk_size_ = std::max(min_chunk_size_, (num_children + max_chunks_ - 1) / max_chunks_);
+    const std::size_t num_chunks = num_chunks_(population_size_, num_elite_);
+    streams_.clear();
+    for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        streams_.emplace_back(eng_());
+    }
+#ifdef GA_TELEMETRY
+    chunk_ns_.resize(num_chunks);
+#endif
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+std::size_t BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::num_chunks_(std::size_t pop_size,
+                                                                                 std::size_t num_elite) noexcept {
+    const std::size_t num_children = pop_size - num_elite;
+    const std::size_t chunk_size = std::max(min_chunk_size_, (num_children + max_chunks_ - 1) / max_chunks_);
+    return (num_children + chunk_size - 1) / chunk_size;
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::set_warm_start(const packed::Word* genes,
+                                                                             std::size_t num_chromosomes) {
+    if (num_chromosomes != 0 && !cf_) {
+        throw std::invalid_argument("The cost function has not been set.");
+    }
+    warm_start_.assign(genes, genes + num_chromosomes * packed::num_words(chromosome_size_));
+    num_warm_start_ = num_chromosomes;
+}
+
+// Creates a new generation of chromosomes by crossing and mutating existing chromosomes.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::new_population(std::size_t num_generations) noexcept {
+    // One extra entry for the final best cost recorded on an early stop
+    best_costs_.reserve(best_costs_.size() + num_generations + 1);
+#ifdef GA_COUNT_ALLOCATIONS
+    const auto allocations_before = alloc_counter::count();
+#endif
+    start_stop_checks_();
+    if (mode_ == Mode::SteadyState) {
+        steady_state_(num_generations);
+#ifdef GA_TELEMETRY
+        telemetry_.flush();
+#endif
+#ifdef GA_COUNT_ALLOCATIONS
+        loop_allocations_ = alloc_counter::count() - allocations_before;
+#endif
+        return;
+    }
+    std::size_t generation = 0;
+    // Advance the GA through the generations using the selection, cross and mutation operators.
+    while (++generation <= num_generations) {
+        if (should_stop_(stop_criteria_.min_diversity > 0.)) {
+            store_best_cost_();
+            break;
+        }
+        store_best_cost_();
+        begin_telemetry_(generation);
+        {
+            GA_TIME_PHASE(select_ns);
+            prepare_selection_();
+        }
+        {
+            GA_TIME_PHASE(cross_ns);
+            // Elite chromosomes are carried over unaltered into the front of the next population, in rank order
+            for (std::size_t rank = 0; rank < num_elite_; ++rank) {
+                next_population_.copy_from(population_, chromosome_at_rank_(rank), rank);
+            }
+        }
+        // The rest of the next population is filled with children
+        for_each_task_(streams_.size(), [this](std::size_t chunk) { produce_chunk_(chunk); });
+        population_.swap(next_population_); // Swap the old population for the new one
+        // Slot numbers now match the ranks the chromosomes were created for
+        std::iota(std::begin(ranks_), std::end(ranks_), 0);
+        mutate_();
+        calculate_costs_(num_elite_);
+        repair_();
+        end_telemetry_();
+    }
+#ifdef GA_TELEMETRY
+    telemetry_.flush();
+#endif
+#ifdef GA_COUNT_ALLOCATIONS
+    loop_allocations_ = alloc_counter::count() - allocations_before;
+#endif
+}
+
+// ranks_[0] is kept pointing at the best chromosome throughout, which is all store_best_cost_ and the children's
+// selection need; the full ranking is only rebuilt once the steps are done.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::steady_state_(std::size_t num_steps) noexcept {
+    const auto worse = [this](std::size_t i, std::size_t j) { return cost_(i) > cost_(j); };
+    std::iota(std::begin(heap_), std::end(heap_), 0);
+    std::make_heap(std::begin(heap_), std::end(heap_), worse);
+    const std::size_t num_children = std::min(num_replacements_, population_size_);
+    const double mutations_per_child = static_cast<double>(num_mutations_) / population_size_;
+    const std::size_t turnover = std::max<std::size_t>(1, population_size_ / num_children);
+    const auto view = selection_view_();
+    for (std::size_t step = 0; step < num_steps; ++step) {
+        if (should_stop_(stop_criteria_.min_diversity > 0. && step % turnover == 0)) {
+            store_best_cost_();
+            break;
+        }
+        store_best_cost_();
+        begin_telemetry_(step + 1);
+        // Breed all the children from the current population before any of them is inserted
+        for (std::size_t child_no = 0; child_no < num_children; ++child_no) {
+            std::size_t couple[2];
+            {
+                GA_TIME_PHASE(select_ns);
+                steady_selection_.TournamentSelection::select(view, eng_, couple, 2);
+                if constexpr (Crossover::avoid_clones) {
+                    avoid_clone_(steady_selection_, view, eng_, couple[0], couple[1]);
+                }
+            }
+            {
+                GA_TIME_PHASE(cross_ns);
+                cross_(couple[0], couple[1], child_no, eng_);
+            }
+            {
+                GA_TIME_PHASE(mutate_ns);
+                mutate_child_(child_no, mutations_per_child);
+            }
+            auto& cost = next_population_.cost(child_no);
+            const auto child = next_population_[child_no].view();
+            {
+                GA_TIME_PHASE(eval_ns);
+                if (use_totals_) {
+                    cost = cf_eval_totals_(next_population_.totals(child_no));
+                } else if (!cache_ || !cache_->find(child, cost)) {
+                    cost = cf_eval_(child);
+                    if (cache_) {
+                        cache_->insert(child, cost);
+                    }
+                }
+            }
+            if (cost == 0) {
+                GA_TIME_PHASE(repair_ns);
+#ifdef GA_TELEMETRY
+                const std::size_t evals_before = counting_cf_->num_evals();
+#endif
+                cost = repair_op_.Repair::repair(repair_cf_(), next_population_[child_no], next_population_.totals(child_no));
+#ifdef GA_TELEMETRY
+                telemetry_record_.repair_evals += counting_cf_->num_evals() - evals_before;
+                ++telemetry_record_.num_repaired;
+#endif
+            }
+            next_population_.mark_dirty(child_no, false);
+        }
+        // Each child replaces the current worst chromosome unless it is worse: O(log P) to pop the worst and
+        // push the child back into its slot. This heap upkeep is the step's ranking.
+        {
+            GA_TIME_PHASE(rank_ns);
+            for (std::size_t child_no = 0; child_no < num_children; ++child_no) {
+                const std::size_t worst = heap_.front();
+                if (next_population_.cost(child_no) < cost_(worst)) {
+                    continue;
+                }
+                std::pop_heap(std::begin(heap_), std::end(heap_), worse);
+                population_.copy_from(next_population_, child_no, worst);
+                std::push_heap(std::begin(heap_), std::end(heap_), worse);
+                if (cost_(worst) > cost_(ranks_[0])) {
+                    ranks_[0] = worst;
+                }
+            }
+        }
+        end_telemetry_();
+    }
+    std::iota(std::begin(ranks_), std::end(ranks_), 0);
+    rank_();
+}
+
+// The number of flips is the integer part of mutations_per_child plus one more with the probability of the fraction
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::mutate_child_(std::size_t child_no,
+                                                                            double mutations_per_child) noexcept {
+    auto num_flips = static_cast<std::size_t>(mutations_per_child);
+    if (std::bernoulli_distribution{mutations_per_child - static_cast<double>(num_flips)}(eng_)) {
+        ++num_flips;
+    }
+    const auto child = next_population_[child_no];
+    for (std::size_t flip = 0; flip < num_flips; ++flip) {
+        const std::size_t gene = rng_(chromosome_size_-1);
+        child.flip(gene);
+        if (use_totals_) {
+            auto& totals = next_population_.totals(child_no);
+            child.test(gene) ? totals += cf_gene_totals_(gene) : totals -= cf_gene_totals_(gene);
+        }
+    }
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::begin_telemetry_([[maybe_unused]] std::size_t generation) noexcept {
+#ifdef GA_TELEMETRY
+    telemetry_record_ = GenerationTelemetry{};
+    telemetry_record_.generation = generation;
+    evals_before_ = total_evals_();
+    for (auto& times : chunk_ns_) {
+        times = {0, 0};
+    }
+#endif
+}
+
+// The offspring chunks time themselves into separate slots, which are summed here once all of them have run
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::end_telemetry_() noexcept {
+#ifdef GA_TELEMETRY
+    for (const auto& [select_ns, cross_ns] : chunk_ns_) {
+        telemetry_record_.select_ns += select_ns;
+        telemetry_record_.cross_ns += cross_ns;
+    }
+    telemetry_record_.best_cost = cost_(ranks_[0]);
+    telemetry_record_.num_evals = total_evals_() - evals_before_;
+    if (diversity_interval_ != 0 && telemetry_record_.generation % diversity_interval_ == 0) {
+        telemetry_record_.diversity = get_diversity();
+    }
+    telemetry_.push(telemetry_record_);
+#endif
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::start_stop_checks_() noexcept {
+    stop_reason_ = StopReason::Generations;
+    start_time_ = std::chrono::steady_clock::now();
+    stall_best_ = cost_(ranks_[0]);
+    stall_count_ = 0;
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+bool BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::time_is_up_() const noexcept {
+    const auto now = std::chrono::steady_clock::now();
+    return (stop_criteria_.time_budget.count() > 0 && now - start_time_ >= stop_criteria_.time_budget) ||
+           (stop_criteria_.deadline && now >= *stop_criteria_.deadline);
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+bool BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::should_stop_(bool check_diversity) noexcept {
+    const std::size_t best_cost = cost_(ranks_[0]);
+    if (best_cost > stall_best_) {
+        stall_best_ = best_cost;
+        stall_count_ = 0;
+    }
+    if (stop_criteria_.cancel && stop_criteria_.cancel->load(std::memory_order_relaxed)) {
+        stop_reason_ = StopReason::Cancelled;
+    } else if (stop_criteria_.target_cost && best_cost >= *stop_criteria_.target_cost) {
+        stop_reason_ = StopReason::TargetReached;
+    } else if (stop_criteria_.stall_generations > 0 && stall_count_++ >= stop_criteria_.stall_generations) {
+        stop_reason_ = StopReason::Stalled;
+    } else if ((stop_criteria_.time_budget.count() > 0 || stop_criteria_.deadline) && time_is_up_()) {
+        stop_reason_ = StopReason::TimeBudget;
+    } else if (check_diversity && get_diversity() < stop_criteria_.min_diversity) {
+        stop_reason_ = StopReason::Converged;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// A gene has converged when it is In in every chromosome or in none: the AND and the OR of its word over the
+// population agree on it
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+double BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::get_diversity() const noexcept {
+    std::size_t diverse = 0;
+    for (std::size_t w = 0; w < population_.words_per_chromosome(); ++w) {
+        packed::Word any = 0;
+        packed::Word all = ~packed::Word{0};
+        for (std::size_t chromosome_no = 0; chromosome_no < population_size_; ++chromosome_no) {
+            any |= population_.words(chromosome_no)[w];
+            all &= population_.words(chromosome_no)[w];
+        }
+        diverse += packed::popcount(any & ~all);
+    }
+    return static_cast<double>(diverse) / chromosome_size_;
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+std::size_t BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::get_solution_generation() const noexcept {
+    return std::distance(std::cbegin(best_costs_), std::find(std::cbegin(best_costs_), std::cend(best_costs_),
+                                             get_best_cost()));
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::export_elites(std::size_t num_chromosomes, packed::Word* genes,
+                                                                            std::size_t* costs) const noexcept {
+    const std::size_t stride = population_.words_per_chromosome();
+    for (std::size_t rank = 0; rank < num_chromosomes; ++rank) {
+        std::copy_n(population_.words(chromosome_at_rank_(rank)), stride, genes + rank * stride);
+        if (costs) {
+            costs[rank] = cost_(chromosome_at_rank_(rank));
+        }
+    }
+}
+
+// The migrants replace the chromosomes at the bottom of the ranking, so the local elites survive whenever
+// num_chromosomes <= population_size - num_elite.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::import_migrants(const packed::Word* genes,
+                                                                              std::size_t num_chromosomes,
+                                                                              const std::size_t* costs) noexcept {
+    const std::size_t stride = population_.words_per_chromosome();
+    num_chromosomes = std::min(num_chromosomes, population_size_);
+    for (std::size_t migrant = 0; migrant < num_chromosomes; ++migrant) {
+        const std::size_t chromosome_no = chromosome_at_rank_(population_size_ - 1 - migrant);
+        const auto chromosome = population_[chromosome_no];
+        std::copy_n(genes + migrant * stride, stride, chromosome.data());
+        population_.mark_dirty(chromosome_no, false);
+        if (use_totals_) {
+            auto& totals = population_.totals(chromosome_no);
+            totals = cf_totals_(chromosome, 0, chromosome_size_);
+            set_cost_(chromosome_no, cf_eval_totals_(totals));
+        } else {
+            set_cost_(chromosome_no, costs ? costs[migrant] : cf_eval_(chromosome.view()));
+        }
+    }
+    rank_();
+}
+
+// Written to a temporary file that then replaces the checkpoint, so a process killed while writing leaves the
+// previous checkpoint intact
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::save_checkpoint(const std::string& filename) const {
+    if (ranks_.empty()) {
+        throw std::invalid_argument("There is no population to checkpoint.");
+    }
+    checkpoint_file::Header header{};
+    std::memcpy(header.magic, checkpoint_file::magic, sizeof(header.magic));
+    header.version = checkpoint_file::version;
+    header.header_size = sizeof(header);
+    header.num_genes = chromosome_size_;
+    header.pop_size = population_size_;
+    header.num_elite = num_elite_;
+    header.t_size = tournament_size_;
+    header.num_mutations = num_mutations_;
+    header.mode = static_cast<std::uint64_t>(mode_);
+    header.num_replacements = num_replacements_;
+    header.num_streams = streams_.size();
+    header.num_best_costs = best_costs_.size();
+
+    const std::string temporary = filename + ".tmp";
+    std::ofstream outfile{temporary, std::ios::binary | std::ios::trunc};
+    const auto write = [&outfile](const void* data, std::size_t size) {
+        outfile.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    };
+    write(&header, sizeof(header));
+    const auto state = eng_.state();
+    write(state.data(), sizeof(state));
+    for (const auto& stream : streams_) {
+        const auto stream_state = stream.state();
+        write(stream_state.data(), sizeof(stream_state));
+    }
+    write(ranks_.data(), sizeof(std::size_t) * population_size_);
+    write(population_.costs(), sizeof(std::size_t) * population_size_);
+    write(best_costs_.data(), sizeof(std::size_t) * best_costs_.size());
+    write(population_.words(0), sizeof(packed::Word) * population_size_ * population_.words_per_chromosome());
+    outfile.close();
+    if (!outfile || std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Could not write the checkpoint file " + filename + '.');
+    }
+}
+
+// The parameters, mode and rng states of the checkpoint replace the GA's own, and the containers are set up as
+// set_parameters would. The cost function must already be set. The running totals are recomputed; nothing is
+// evaluated.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::load_checkpoint(const std::string& filename) {
+    if (!cf_) {
+        throw std::invalid_argument("The cost function has not been set.");
+    }
+    std::ifstream infile{filename, std::ios::binary | std::ios::ate};
+    if (!infile) {
+        throw std::runtime_error("Could not open the checkpoint file " + filename + '.');
+    }
+    const auto size = static_cast<std::size_t>(infile.tellg());
+    infile.seekg(0);
+    checkpoint_file::Header header{};
+    if (size >= sizeof(header)) {
+        infile.read(reinterpret_cast<char*>(&header), sizeof(header));
+    }
+    if (size < sizeof(header) || std::memcmp(header.magic, checkpoint_file::magic, sizeof(header.magic)) != 0 ||
+        header.version != checkpoint_file::version || header.header_size != sizeof(header) ||
+        size != checkpoint_file::file_size(header, packed::num_words(header.num_genes))) {
+        throw std::invalid_argument(filename + " is not a GA checkpoint.");
+    }
+    if (header.num_genes != chromosome_size_ || header.pop_size == 0 || header.num_elite >= header.pop_size ||
+        header.t_size == 0 || header.mode > static_cast<std::uint64_t>(Mode::SteadyState) ||
+        header.num_replacements == 0 || header.num_streams != num_chunks_(header.pop_size, header.num_elite)) {
+        throw std::invalid_argument(filename + " is not a checkpoint of a GA for this cost function.");
+    }
+    population_size_ = header.pop_size;
+    num_elite_ = header.num_elite;
+    tournament_size_ = header.t_size;
+    num_mutations_ = header.num_mutations;
+    mode_ = static_cast<Mode>(header.mode);
+    num_replacements_ = header.num_replacements;
+    allocate_();
+
+    const auto read = [&infile](void* data, std::size_t size) {
+        infile.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    };
+    Engine::State state{};
+    read(state.data(), sizeof(state));
+    eng_.set_state(state);
+    for (auto& stream : streams_) {
+        read(state.data(), sizeof(state));
+        stream.set_state(state);
+    }
+    read(ranks_.data(), sizeof(std::size_t) * population_size_);
+    read(population_.costs(), sizeof(std::size_t) * population_size_);
+    best_costs_.resize(header.num_best_costs);
+    read(best_costs_.data(), sizeof(std::size_t) * best_costs_.size());
+    read(population_.words(0), sizeof(packed::Word) * population_size_ * population_.words_per_chromosome());
+    if (!infile) {
+        throw std::runtime_error("Could not read the checkpoint file " + filename + '.');
+    }
+    // The ranks index the population, so anything but a permutation of [0, pop_size) would read out of bounds
+    std::vector<bool> ranked(population_size_, false);
+    for (const auto chromosome_no : ranks_) {
+        if (chromosome_no >= population_size_ || ranked[chromosome_no]) {
+            throw std::invalid_argument(filename + " does not hold a valid ranking of the population.");
+        }
+        ranked[chromosome_no] = true;
+    }
+    for (std::size_t chromosome_no = 0; chromosome_no < population_size_; ++chromosome_no) {
+        population_.mark_dirty(chromosome_no, false);
+        if (use_totals_) {
+            population_.totals(chromosome_no) = cf_totals_(population_[chromosome_no], 0, chromosome_size_);
+        }
+    }
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::prep_outfile(const std::string& filename, std::size_t num_gens,
+                                                                           std::size_t num_runs) const {
+    std::ofstream outfile {filename, std::ios::trunc}; // overwrites existing file
+    outfile << population_size_ << '\n';
+    outfile << num_elite_ << '\n';
+    outfile << tournament_size_ << '\n';
+    outfile << static_cast<double>(num_mutations_)/population_size_/cf_->num_vars() << '\n';
+    outfile << num_gens << '\n';
+    outfile << num_runs << '\n';
+    outfile.close();
+}
+
+// Appends the best cost in each generation to the input file.
+// num_gens +1 representing the best solutions from each generation including the initial generations
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::export_results(const std::string& filename) const {
+    std::ofstream outfile {filename, std::ios::app}; // appends to existing file
+    outfile << '\n';
+    outfile << get_solution_generation()+1 << '\n';
+    std::copy(std::cbegin(best_costs_), std::cend(best_costs_), std::ostream_iterator<std::size_t>(outfile, "\n"));
+    outfile.close();
+}
+
+// Displays the chromosome and gene values. Orders them by rank (highest fitness/cost displayed first)
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+std::ostream& BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::print(std::ostream& os) const {
+    for (const auto& chromosome_no : ranks_) {
+        os << "Chromosome " << chromosome_no << " - Cost(" << cost_(chromosome_no) << "): ";
+        const auto genes = population_[chromosome_no];
+        for (std::size_t gene = 0; gene < chromosome_size_; ++gene) {
+            os << (genes.test(gene) ? "In " : "Out ");
+        }
+        os << '\n';
+    }
+    return os;
+}
+
+// Initializes all the chromosomes with random genes (either Out (0) or In (1)), after the warm start chromosomes.
+// Feasible warm start chromosomes need no repair, so seeding the population saves the repair's evaluations too.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::rand_init_() noexcept {
+    const std::size_t num_seeded = std::min(num_warm_start_, population_size_);
+    const std::size_t stride = population_.words_per_chromosome();
+    for (std::size_t chromosome_no = 0; chromosome_no < population_size_; ++chromosome_no) {
+        const auto chromosome = population_[chromosome_no];
+        if (chromosome_no < num_seeded) {
+            std::copy_n(warm_start_.data() + chromosome_no * stride, stride, chromosome.data());
+        } else {
+            std::generate(chromosome.data(), chromosome.data() + chromosome.num_words(), [this]() { return rng_word_(eng_); });
+        }
+        chromosome.trim();
+        population_.mark_dirty(chromosome_no);
+        if (use_totals_) {
+            population_.totals(chromosome_no) = cf_totals_(chromosome, 0, chromosome_size_);
+        }
+    }
+    calculate_costs_();
+    repair_(); // Ensure starting chromosomes are feasible
+}
+
+// Produces the children of one chunk from the chunk's own rng stream. The chunk covers the next population slots
+// [num_elite_ + chunk * chunk_size_, num_elite_ + (chunk + 1) * chunk_size_) clamped to the population size.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::produce_chunk_(std::size_t chunk) noexcept {
+    auto& eng = streams_[chunk];
+    const std::size_t first = num_elite_ + chunk * chunk_size_;
+    const std::size_t last = std::min(first + chunk_size_, population_size_);
+    // The parents of the whole chunk are drawn in one call, two per child
+    const auto view = selection_view_();
+    auto* parents = parents_.data() + 2 * (first - num_elite_);
+#ifdef GA_TELEMETRY
+    // Chunks run concurrently, so each one times itself into its own slot
+    std::optional<PhaseTimer> timer(std::in_place, chunk_ns_[chunk][0]);
+#endif
+    selection_.Selection::select(view, eng, parents, 2 * (last - first));
+#ifdef GA_TELEMETRY
+    timer.emplace(chunk_ns_[chunk][1]);
+#endif
+    for (std::size_t rank = first; rank < last; ++rank) {
+        const auto* couple = parents + 2 * (rank - first);
+        auto parent2 = couple[1];
+        // No clones unless the crossover allows them
+        if constexpr (Crossover::avoid_clones) {
+            avoid_clone_(selection_, view, eng, couple[0], parent2);
+        }
+        // Write a new child chromosome into the slot for the given rank
+        cross_(couple[0], parent2, rank, eng);
+    }
+}
+
+// Calculates and stores the costs of each chromosome in the current generation.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::calculate_costs_(std::size_t num_elite) noexcept {
+    if (cache_ && !use_totals_) {
+        cached_costs_(num_elite);
+    } else {
+        evaluate_dirty_(num_elite);
+    }
+    rank_();
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::evaluate_dirty_(std::size_t num_elite) noexcept {
+    GA_TIME_PHASE(eval_ns);
+    // Evaluated in contiguous slot ranges, one per task - each task writes the costs of different chromosomes
+    const std::size_t num_tasks = num_tasks_();
+    const std::size_t num_evaluated = population_size_ - num_elite;
+    for_each_task_(num_tasks, [&](std::size_t task) {
+        const std::size_t first = num_elite + num_evaluated * task / num_tasks;
+        const std::size_t last = num_elite + num_evaluated * (task + 1) / num_tasks;
+        if (use_totals_) {
+            for (std::size_t chromosome_no = first; chromosome_no < last; ++chromosome_no) {
+                set_cost_(chromosome_no, cf_eval_totals_(population_.totals(chromosome_no)));
+                population_.mark_dirty(chromosome_no, false);
+            }
+            return;
+        }
+        // Each run of consecutive dirty chromosomes is one batch
+        for (std::size_t run_first = first; run_first < last;) {
+            if (!population_.is_dirty(run_first)) {
+                ++run_first;
+                continue;
+            }
+            std::size_t run_last = run_first;
+            while (run_last < last && population_.is_dirty(run_last)) {
+                population_.mark_dirty(run_last++, false);
+            }
+            cf_eval_batch_(population_.words(run_first), run_last - run_first, population_.costs() + run_first);
+            run_first = run_last;
+        }
+    });
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::cached_costs_(std::size_t num_elite) noexcept {
+    GA_TIME_PHASE(eval_ns);
+    std::size_t num_misses = 0;
+    for (std::size_t chromosome_no = num_elite; chromosome_no < population_size_; ++chromosome_no) {
+        if (population_.is_dirty(chromosome_no)) {
+            population_.mark_dirty(chromosome_no, false);
+            if (!cache_->find(population_[chromosome_no], population_.cost(chromosome_no))) {
+                misses_[num_misses++] = chromosome_no;
+            }
+        }
+    }
+    const std::size_t num_tasks = num_tasks_();
+    for_each_task_(num_tasks, [&](std::size_t task) {
+        const std::size_t last = num_misses * (task + 1) / num_tasks;
+        for (std::size_t miss = num_misses * task / num_tasks; miss < last; ++miss) {
+            set_cost_(misses_[miss], cf_eval_(population_[misses_[miss]]));
+        }
+    });
+    // Duplicates among the misses are evaluated more than once but only stored once
+    for (std::size_t miss = 0; miss < num_misses; ++miss) {
+        cache_->insert(population_[misses_[miss]], cost_(misses_[miss]));
+    }
+}
+
+// Sort the rankings according to the current costs. Highest cost chromosome is rank 0 etc.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::rank_() noexcept {
+    GA_TIME_PHASE(rank_ns);
+    std::sort(std::begin(ranks_), std::end(ranks_),
+              [this](std::size_t i, std::size_t j){ return cost_(i) > cost_(j);} );
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+SelectionView BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::selection_view_() const noexcept {
+    const bool cumulative = selection_.Selection::needs_cumulative();
+    return {population_.costs(), ranks_.data(), cumulative ? cumulative_.data() : nullptr, population_size_};
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::prepare_selection_() noexcept {
+    if (selection_.Selection::needs_cumulative()) {
+        std::partial_sum(population_.costs(), population_.costs() + population_size_, std::begin(cumulative_));
+    }
+}
+
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+template <typename Policy>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::avoid_clone_(const Policy& policy, const SelectionView& view,
+                                                                           Engine& eng, std::size_t parent1,
+                                                                           std::size_t& parent2) const noexcept {
+    for (std::size_t redraw = 0; parent2 == parent1 && redraw < max_redraws_; ++redraw) {
+        policy.Policy::select(view, eng, &parent2, 1);
+    }
+    // Policies that concentrate on a single chromosome (e.g. SUS when one has all the fitness) end up here
+    if (parent2 == parent1 && population_size_ > 1) {
+        parent2 = rng_(eng, population_size_ - 2);
+        parent2 += (parent2 >= parent1);
+    }
+}
+
+// The crossover policy writes the child. A spliced child's totals are those of one parent with the other half
+// swapped out - only the shorter half is scanned.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::cross_(std::size_t p1_chromosome_no,
+                                                                     std::size_t p2_chromosome_no, std::size_t child_no,
+                                                                     Engine& eng) noexcept {
+    const auto result = crossover_.Crossover::cross(population_[p1_chromosome_no], cost_(p1_chromosome_no),
+                                                    population_[p2_chromosome_no], cost_(p2_chromosome_no),
+                                                    next_population_[child_no], eng);
+    if (use_totals_) {
+        auto& child_totals = next_population_.totals(child_no);
+        if (!result.spliced) {
+            // Any gene may have changed so the child's totals are computed from scratch
+            child_totals = cf_totals_(next_population_[child_no], 0, chromosome_size_);
+        } else {
+            const std::size_t head_no = result.second_is_head ? p2_chromosome_no : p1_chromosome_no;
+            const std::size_t tail_no = result.second_is_head ? p1_chromosome_no : p2_chromosome_no;
+            const auto head = population_[head_no];
+            const auto tail = population_[tail_no];
+            const std::size_t mid = result.mid;
+            if (mid <= chromosome_size_ - mid) {
+                child_totals = population_.totals(tail_no) - cf_totals_(tail, 0, mid) + cf_totals_(head, 0, mid);
+            } else {
+                child_totals = population_.totals(head_no) - cf_totals_(head, mid, chromosome_size_)
+                               + cf_totals_(tail, mid, chromosome_size_);
+            }
+        }
+    }
+    inherit_cost_(p1_chromosome_no, p2_chromosome_no, child_no);
+}
+
+// Once the population converges many children are copies of a parent. The comparison costs no more than the
+// crossover itself and saves an evaluation; with running totals the cost is O(1) anyway so it is skipped.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::inherit_cost_(std::size_t p1_chromosome_no,
+                                                                            std::size_t p2_chromosome_no,
+                                                                            std::size_t child_no) noexcept {
+    next_population_.mark_dirty(child_no);
+    if (use_totals_) {
+        return;
+    }
+    const auto* child = next_population_.words(child_no);
+    const std::size_t stride = population_.words_per_chromosome();
+    for (const auto parent_no : {p1_chromosome_no, p2_chromosome_no}) {
+        if (std::equal(child, child + stride, population_.words(parent_no))) {
+            next_population_.cost(child_no) = cost_(parent_no);
+            next_population_.mark_dirty(child_no, false);
+            return;
+        }
+    }
+}
+
+// Elites occupy slots [0, num_elite_) when this is called, so the mutable genes are the contiguous range
+// [num_elite_ * n, P * n) of gene positions, which the mutation policy picks the flipped positions from.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::mutate_() noexcept {
+    GA_TIME_PHASE(mutate_ns);
+    const std::size_t num_positions = (population_size_ - num_elite_) * chromosome_size_;
+    mutation_.Mutation::mutate(eng_, num_positions, [this](std::size_t position) {
+        const std::size_t chromosome_no = num_elite_ + position / chromosome_size_;
+        const std::size_t gene = position % chromosome_size_;
+        const auto member_chromosome = population_[chromosome_no];
+        member_chromosome.flip(gene);
+        population_.mark_dirty(chromosome_no);
+        if (use_totals_) {
+            auto& totals = population_.totals(chromosome_no);
+            member_chromosome.test(gene) ? totals += cf_gene_totals_(gene) : totals -= cf_gene_totals_(gene);
+        }
+    });
+}
+
+// This function assume a chromosome with a cost of 0 is not feasible. This may not always be the case but
+// it will suffice for the project.
+// Repairs unfeasible chromosomes with the repair policy (TrimRepair unless set_repair chose another one).
+// Chromosomes are repaired independently so the population is split into ranges, one per task.
+template <typename CostFn, typename Selection, typename Crossover, typename Mutation, typename Repair>
+void BasicGA<CostFn, Selection, Crossover, Mutation, Repair>::repair_() noexcept {
+    std::atomic<bool> repair_flag{false};
+    {
+        GA_TIME_PHASE(repair_ns);
+#ifdef GA_TELEMETRY
+        std::atomic<std::size_t> num_repaired{0};
+        const std::size_t evals_before = counting_cf_->num_evals();
+#endif
+        const std::size_t num_tasks = num_tasks_();
+        for_each_task_(num_tasks, [&](std::size_t task) {
+            const std::size_t last = population_size_ * (task + 1) / num_tasks;
+            for (std::size_t chromosome_no = population_size_ * task / num_tasks; chromosome_no < last; ++chromosome_no) {
+                // If the chromosome is not feasible, we repair it
+                if (cost_(chromosome_no) == 0) {
+                    set_cost_(chromosome_no, repair_op_.Repair::repair(repair_cf_(), population_[chromosome_no],
+                                                                       population_.totals(chromosome_no)));
+                    repair_flag.store(true, std::memory_order_relaxed);
+#ifdef GA_TELEMETRY
+                    num_repaired.fetch_add(1, std::memory_order_relaxed);
+#endif
+                }
+            }
+        });
+#ifdef GA_TELEMETRY
+        telemetry_record_.num_repaired += num_repaired.load(std::memory_order_relaxed);
+        telemetry_record_.repair_evals += counting_cf_->num_evals() - evals_before;
+#endif
+    }
+    // Repaired chromosomes have their new costs stored so only the ranking needs to be refreshed.
+    if (repair_flag) {
+        rank_();
+    }
+}
+
+#endif //PROJECT_BASICGA_H
@@ -0,0 +1,105 @@
+#include <algorithm>    // std::max, std::stable_sort
+#include <atomic>
+#include <exception>    // std::exception_ptr
+#include <mutex>
+#include <numeric>      // std::iota
+#include <thread>       // std::thread::hardware_concurrency
+#include <tuple>        // Job shapes
+
+#include "BatchRunner.h"
+#include "ThreadPool.h"
+
+namespace {
+    // Sort key for the shape of the buffers a job's GA needs: the gene arena size, then the population and
+    // chromosome sizes, so jobs of identical shape compare equal
+    std::tuple<std::size_t, std::size_t, std::size_t> shape(const BatchRunner::Job& job) noexcept {
+        const std::size_t num_genes = job.cf ? job.cf->num_vars() : 0;
+        const std::size_t pop_size = job.parameters.pop_size;
+        return {pop_size * packed::num_words(num_genes), pop_size, num_genes};
+    }
+}
+
+BatchRunner::BatchRunner(std::size_t num_workers) {
+    set_num_workers(num_workers);
+}
+
+void BatchRunner::set_num_workers(std::size_t num_workers) {
+    if (num_workers == 0) {
+        num_workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.clear();
+    for (std::size_t worker = 0; worker < num_workers; ++worker) {
+        workers_.push_back(std::make_unique<GA>());
+    }
+}
+
+std::size_t BatchRunner::add_job(const Job& job) {
+    jobs_.push_back(job);
+    results_.emplace_back();
+    return jobs_.size() - 1;
+}
+
+void BatchRunner::clear() noexcept {
+    jobs_.clear();
+    results_.clear();
+    num_done_ = 0;
+}
+
+// Each worker pulls the next job from a shared counter until none are left. The pending jobs are handed out largest
+// shape first, so a worker's GA buffers are sized by its first job and then reused without reallocating by the
+// no larger jobs that follow, and jobs of the same shape run back to back. The first exception thrown by a job stops
+// the remaining jobs from starting and is rethrown once every worker has finished.
+void BatchRunner::run() {
+    std::vector<std::size_t> order(jobs_.size() - num_done_);
+    std::iota(std::begin(order), std::end(order), num_done_);
+    std::stable_sort(std::begin(order), std::end(order),
+                     [this](std::size_t i, std::size_t j) { return shape(jobs_[i]) > shape(jobs_[j]); });
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    ThreadPool pool(std::min(workers_.size(), std::max<std::size_t>(1, order.size())));
+    pool.parallel_for(pool.size(), [&](std::size_t worker) {
+        for (std::size_t index; (index = next.fetch_add(1)) < order.size();) {
+            try {
+                run_job_(*workers_[worker], order[index]);
+            } catch (...) {
+                std::lock_guard lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next = order.size();
+            }
+        }
+    });
+    num_done_ = jobs_.size();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void BatchRunner::run_job_(GA& ga, std::size_t job_no) {
+    const auto& [cf, parameters, seed] = jobs_[job_no];
+    ga.set_seed(seed);
+    ga.set_cf(cf);
+    ga.set_parameters(parameters.pop_size, parameters.num_elite, parameters.t_size, parameters.mutation_rate);
+    ga.new_population(parameters.num_gens);
+    auto& result = results_[job_no];
+    result.best_cost = ga.get_best_cost();
+    result.solution_generation = ga.get_solution_generation();
+    result.best_costs = ga.get_best_costs();
+    result.best_chromosome = ga.get_best_chromosome();
+}
+
+// The header reports the effective mutation rate (the rate the GA's mutation count corresponds to), as
+// GA::prep_outfile does
+void BatchRunner::write_results(ResultsSink& sink, const std::string& filename, std::size_t first_job, std::size_t num_runs) const {
+    const auto& [cf, parameters, seed] = jobs_[first_job];
+    sink.open(filename, ResultsHeader::make(parameters.pop_size, parameters.num_elite, parameters.t_size,
+                                            parameters.mutation_rate, cf->num_vars(), parameters.num_gens, num_runs));
+    for (std::size_t run_no = 0; run_no < num_runs; ++run_no) {
+        const auto& result = results_[first_job + run_no];
+        // Solution generations are 1-based, as in the text results files
+        sink.write_run(run_no, result.solution_generation+1, result.best_costs.data(), result.best_costs.size());
+    }
+    sink.close();
+}
@@ -0,0 +1,74 @@
+#ifndef PROJECT_BATCHRUNNER_H
+#define PROJECT_BATCHRUNNER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GA.h"
+#include "ResultsSink.h"
+
+// Runs many independent GA experiments concurrently. A job is a cost function, a GA parameter set and a seed; the
+// jobs are handed out to a fixed set of workers, each of which owns one GA that is reused (and whose buffers are
+// reused) from job to job. Jobs are started largest shape first so the buffers rarely need to grow. Results are kept
+// in memory and only written when asked for, each file in one go.
+// A job's result only depends on the job, never on the number of workers or which worker ran it.
+class BatchRunner {
+public:
+    using Chromosome = BinaryCostFunction::Chromosome;
+
+    struct Parameters {
+        std::size_t pop_size = 0;
+        std::size_t num_elite = 0;
+        std::size_t t_size = 0;
+        double mutation_rate = 0.;
+        std::size_t num_gens = 0;
+    };
+
+    struct Job {
+        const BinaryCostFunction* cf = nullptr;
+        Parameters parameters;
+        std::size_t seed = 0;
+    };
+
+    struct Result {
+        std::size_t best_cost = 0;
+        std::size_t solution_generation = 0;    // Generation in which the best cost was first reached
+        std::vector<std::size_t> best_costs;    // Best cost of each generation
+        Chromosome best_chromosome;
+    };
+
+    // Creates a runner with the given number of workers - 0 (the default) uses one per hardware thread
+    explicit BatchRunner(std::size_t num_workers = 0);
+
+    // Replaces the workers (and their GA buffers) - 0 uses one per hardware thread. Results do not change.
+    void set_num_workers(std::size_t num_workers);
+
+    // Queues a job and returns its number, which is also the index of its result
+    std::size_t add_job(const Job& job);
+
+    // Runs every queued job that has not been run yet. Will throw if a job's cost function or parameters are invalid.
+    void run();
+
+    // Removes all jobs and results
+    void clear() noexcept;
+
+    [[nodiscard]] std::size_t num_jobs() const noexcept { return jobs_.size(); }
+    [[nodiscard]] const Job& job(std::size_t job_no) const noexcept { return jobs_[job_no]; }
+    [[nodiscard]] const Result& result(std::size_t job_no) const noexcept { return results_[job_no]; }
+
+    // Writes the results of jobs [first_job, first_job + num_runs) to one file through the sink, as runs
+    // [0, num_runs). The jobs must share their cost function and parameters.
+    void write_results(ResultsSink& sink, const std::string& filename, std::size_t first_job, std::size_t num_runs) const;
+
+    BatchRunner &operator=(const BatchRunner &) = delete;
+    BatchRunner(const BatchRunner &) = delete;
+private:
+    std::vector<std::unique_ptr<GA>> workers_;
+    std::vector<Job> jobs_;
+    std::vector<Result> results_;
+    std::size_t num_done_ = 0;  // Jobs [0, num_done_) have been run
+
+    void run_job_(GA& ga, std::size_t job_no);
+};
+#endif //PROJECT_BATCHRUNNER_H
@@ -3,6 +3,8 @@
 
 #include <vector>
 
+#include "PackedChromosome.h"
+
 // Abstract base class for a binary cost function. Derived classes
 // must implement the eval function which evaluates the input chromosomes
 // and returns its fitness or cost.
@@ -11,6 +13,20 @@ public:
     enum class Gene { Out=0, In=1 }; // vector<bool> might work here but it is generally to be avoided (dynamic bitset not in STL).
     using Chromosome = std::vector<Gene>;
 
+    // Running totals of a chromosome for cost functions whose cost is a function of sums over the In genes
+    // (total weight, total value and number of items for a knapsack). Totals of disjoint gene ranges add up, so
+    // they can be updated in O(1) per flipped gene and in O(changed range) after a crossover.
+    struct Totals {
+        std::size_t weight = 0;
+        std::size_t value = 0;
+        std::size_t count = 0;
+
+        Totals& operator+=(const Totals& rhs) noexcept { weight += rhs.weight; value += rhs.value; count += rhs.count; return *this; }
+        Totals& operator-=(const Totals& rhs) noexcept { weight -= rhs.weight; value -= rhs.value; count -= rhs.count; return *this; }
+        friend Totals operator+(Totals lhs, const Totals& rhs) noexcept { return lhs += rhs; }
+        friend Totals operator-(Totals lhs, const Totals& rhs) noexcept { return lhs -= rhs; }
+    };
+
     constexpr explicit BinaryCostFunction(std::size_t num_vars) noexcept : num_vars_(num_vars) {};
 
     // Destructor is virtual in the abstract base class
@@ -19,8 +35,56 @@ public:
     // Evaluates the input chromosome and returns its fitness/cost.
     [[nodiscard]] virtual std::size_t eval(const Chromosome& chromosome) const = 0;
 
+    // Evaluates a bit-packed chromosome. Overriding this is optional - the default unpacks the genes and
+    // forwards to the unpacked eval, so it only pays to override it when the cost can be computed word by word.
+    [[nodiscard]] virtual std::size_t eval(PackedView chromosome) const { return eval(unpack(chromosome)); }
+
+    // Evaluates num_chromosomes packed chromosomes stored back to back (chromosome i starts at
+    // genes + i * words_per_chromosome) and writes their costs to costs[0, num_chromosomes). The default calls eval
+    // once per chromosome; derived classes can override it to process the whole batch in one pass (SIMD, GPU or
+    // remote evaluators hook in here).
+    virtual void eval_batch(const packed::Word* genes, std::size_t words_per_chromosome, std::size_t num_chromosomes,
+                            std::size_t* costs) const {
+        for (std::size_t chromosome_no = 0; chromosome_no < num_chromosomes; ++chromosome_no) {
+            costs[chromosome_no] = eval(PackedView(genes + chromosome_no * words_per_chromosome, num_vars_));
+        }
+    }
+
+    // Delta evaluation interface. Cost functions that can be expressed through Totals override these and return true
+    // from supports_totals(); callers must check supports_totals() before using the other three.
+    [[nodiscard]] virtual bool supports_totals() const noexcept { return false; }
+    // Totals of the In genes in [first_gene, last_gene) of the chromosome
+    [[nodiscard]] virtual Totals totals(PackedView, std::size_t /*first_gene*/, std::size_t /*last_gene*/) const noexcept { return {}; }
+    // Contribution of a single gene when it is In
+    [[nodiscard]] virtual Totals gene_totals(std::size_t /*gene*/) const noexcept { return {}; }
+    // Fitness/cost of a chromosome with the given totals - same result as eval on the chromosome itself
+    [[nodiscard]] virtual std::size_t eval_totals(const Totals&) const noexcept { return 0; }
+    // Whether a chromosome with the given totals satisfies the constraints. Solvers that prune assume that once a
+    // chromosome is unfeasible, adding more In genes never makes it feasible again (true for knapsacks).
+    [[nodiscard]] virtual bool feasible(const Totals& totals) const noexcept { return eval_totals(totals) != 0; }
+
     // Accessor for the number of variables
     [[nodiscard]] std::size_t num_vars() const noexcept { return num_vars_; }
+
+    // Conversions between the unpacked and bit-packed chromosome representations
+    [[nodiscard]] static PackedChromosome pack(const Chromosome& chromosome) {
+        PackedChromosome packed(chromosome.size());
+        for (std::size_t gene = 0; gene < chromosome.size(); ++gene) {
+            if (chromosome[gene] == Gene::In) {
+                packed.set(gene);
+            }
+        }
+        return packed;
+    }
+    [[nodiscard]] static Chromosome unpack(PackedView packed) {
+        Chromosome chromosome(packed.num_genes(), Gene::Out);
+        for (std::size_t gene = 0; gene < packed.num_genes(); ++gene) {
+            if (packed.test(gene)) {
+                chromosome[gene] = Gene::In;
+            }
+        }
+        return chromosome;
+    }
 private:
     // The number of variables that the cost function will use to evaluate chromosomes.
     const std::size_t num_vars_;
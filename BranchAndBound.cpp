@@ -0,0 +1,251 @@
+#include <algorithm>    // std::upper_bound
+#include <ostream>
+#include <stdexcept>    // std::invalid_argument
+#include <thread>       // std::thread::hardware_concurrency, std::this_thread::yield
+
+#include "BranchAndBound.h"
+#include "ThreadPool.h"
+
+using std::invalid_argument; // If cost function has not been set
+
+namespace {
+    // Nodes explored between deadline checks
+    constexpr std::size_t check_interval = 1024;
+}
+
+void BranchAndBound::set_cf(const Knapsack* cf) noexcept {
+    cf_ = cf;
+    best_ = std::make_pair(0, PackedChromosome(cf->num_vars()));
+    optimal_ = false;
+    num_nodes_ = 0;
+}
+
+void BranchAndBound::set_incumbent(const Chromosome& chromosome) {
+    set_incumbent(BinaryCostFunction::pack(chromosome));
+}
+
+void BranchAndBound::set_incumbent(PackedView chromosome) {
+    if (!cf_) {
+        throw invalid_argument("The cost function has not been set.");
+    }
+    if (chromosome.num_genes() != cf_->num_vars()) {
+        throw invalid_argument("The incumbent does not match the cost function.");
+    }
+    // Knapsack::eval is 0 for unfeasible chromosomes, so they never replace the incumbent
+    if (const std::size_t cost = cf_->eval(chromosome); cost > best_.first) {
+        best_ = std::make_pair(cost, PackedChromosome(chromosome));
+    }
+}
+
+void BranchAndBound::solve() {
+    if (!cf_) {
+        throw invalid_argument("The cost function has not been set.");
+    }
+    const std::size_t num_genes = cf_->num_vars();
+    if (const auto& [greedy_cost, greedy_chromosome] = cf_->greedy_solve(); greedy_cost > best_.first) {
+        best_ = std::make_pair(greedy_cost, BinaryCostFunction::pack(greedy_chromosome));
+    }
+
+    // Items in ratio order with prefix sums, so the fractional bound of a node is found by a binary search
+    order_ = cf_->ratio_order();
+    weights_.resize(num_genes);
+    prices_.resize(num_genes);
+    weight_sums_.assign(num_genes + 1, 0);
+    price_sums_.assign(num_genes + 1, 0);
+    max_prices_.assign(num_genes + 1, 0);
+    for (std::size_t pos = 0; pos < num_genes; ++pos) {
+        weights_[pos] = cf_->weights()[order_[pos]];
+        prices_[pos] = cf_->prices()[order_[pos]];
+        weight_sums_[pos + 1] = weight_sums_[pos] + weights_[pos];
+        price_sums_[pos + 1] = price_sums_[pos] + prices_[pos];
+    }
+    for (std::size_t pos = num_genes; pos-- > 0;) {
+        max_prices_[pos] = std::max(max_prices_[pos + 1], prices_[pos]);
+    }
+
+    const std::size_t num_threads = num_threads_ ? num_threads_ : std::max(1u, std::thread::hardware_concurrency());
+    workers_ = std::vector<Worker>(num_threads);
+    workers_[0].nodes.push_back(Node{0, 0, 0, 0, PackedChromosome(num_genes)});
+    incumbent_ = best_.first;
+    outstanding_ = 1;
+    idle_ = 0;
+    nodes_ = 0;
+    stop_ = false;
+    deadline_ = std::chrono::steady_clock::now() + budget_;
+
+    ThreadPool pool(num_threads);
+    pool.parallel_for(num_threads, [this](std::size_t thread_no) { work_(thread_no); });
+
+    optimal_ = !stop_;
+    num_nodes_ = nodes_;
+    // The search state is only needed during the solve
+    workers_ = std::vector<Worker>();
+    order_ = {};
+    weights_ = {};
+    prices_ = {};
+    weight_sums_ = {};
+    price_sums_ = {};
+    max_prices_ = {};
+}
+
+// Items [depth, n) are undecided. The fractional bound takes them whole in ratio order while they fit and then a
+// fraction of the first one that does not. The item limit alone allows at most the remaining count of the highest
+// remaining price.
+std::size_t BranchAndBound::bound_(std::size_t depth, std::size_t weight, std::size_t value, std::size_t count) const noexcept {
+#ifdef __SIZEOF_INT128__
+    using Wide = unsigned __int128;
+#else
+    using Wide = long double;
+#endif
+    const std::size_t num_genes = weights_.size();
+    const std::size_t capacity = cf_->max_weight() - weight;
+    const std::size_t items = cf_->max_items() - count;
+    // Last position whose prefix still fits - items [depth, last) are taken whole
+    const auto first = std::begin(weight_sums_) + static_cast<std::ptrdiff_t>(depth);
+    const auto last = static_cast<std::size_t>(std::upper_bound(first, std::end(weight_sums_), weight_sums_[depth] + capacity)
+                                               - std::begin(weight_sums_)) - 1;
+    std::size_t bound = value + price_sums_[last] - price_sums_[depth];
+    if (last < num_genes) {
+        const std::size_t left = capacity - (weight_sums_[last] - weight_sums_[depth]);
+        bound += static_cast<std::size_t>(static_cast<Wide>(prices_[last]) * left / weights_[last]);
+    }
+    if (items < num_genes - depth) {
+        bound = std::min(bound, value + items * max_prices_[depth]);
+    }
+    return bound;
+}
+
+void BranchAndBound::work_(std::size_t thread_no) {
+    std::size_t local_nodes = 0;
+    bool idle = false;
+    Node node;
+    std::vector<Frame> path;
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (next_node_(thread_no, node)) {
+            if (idle) {
+                idle = false;
+                idle_.fetch_sub(1, std::memory_order_relaxed);
+            }
+            explore_(thread_no, node, path, local_nodes);
+            outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+        } else if (outstanding_.load(std::memory_order_acquire) == 0) {
+            break;
+        } else {
+            if (!idle) {
+                idle = true;
+                idle_.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::this_thread::yield();
+        }
+    }
+    if (idle) {
+        idle_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    nodes_.fetch_add(local_nodes, std::memory_order_relaxed);
+}
+
+// Takes the newest node of the thread's own deque, or else steals the oldest node of another thread's
+bool BranchAndBound::next_node_(std::size_t thread_no, Node& node) {
+    {
+        auto& own = workers_[thread_no];
+        std::lock_guard lock(own.mutex);
+        if (!own.nodes.empty()) {
+            node = std::move(own.nodes.back());
+            own.nodes.pop_back();
+            return true;
+        }
+    }
+    for (std::size_t offset = 1; offset < workers_.size(); ++offset) {
+        auto& victim = workers_[(thread_no + offset) % workers_.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.nodes.empty()) {
+            node = std::move(victim.nodes.front());
+            victim.nodes.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+// Tries the next item In first (the greedy direction, which finds good incumbents early) and then Out. When another
+// thread is idle the Out branch is queued for it instead of being searched here. Once a subtree is done the path is
+// unwound, undoing the In items, up to the deepest position whose Out branch is still pending.
+void BranchAndBound::explore_(std::size_t thread_no, Node& node, std::vector<Frame>& path, std::size_t& local_nodes) {
+    path.clear();
+    for (bool descend = true; descend;) {
+        if (++local_nodes % check_interval == 0 && budget_.count() > 0 && std::chrono::steady_clock::now() >= deadline_) {
+            stop_.store(true, std::memory_order_relaxed);
+        }
+        if (stop_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        if (node.value > incumbent_.load(std::memory_order_relaxed)) {
+            record_(node);
+        }
+        if (node.depth < weights_.size() &&
+            bound_(node.depth, node.weight, node.value, node.count) > incumbent_.load(std::memory_order_relaxed)) {
+            const std::size_t pos = node.depth++;
+            const bool share = idle_.load(std::memory_order_relaxed) > 0;
+            if (share) {
+                outstanding_.fetch_add(1, std::memory_order_acq_rel);
+                auto& own = workers_[thread_no];
+                std::lock_guard lock(own.mutex);
+                own.nodes.push_back(node);
+            }
+            const bool in = node.weight + weights_[pos] <= cf_->max_weight() && node.count < cf_->max_items();
+            path.push_back(Frame{pos, in, !share});
+            if (in) {
+                node.weight += weights_[pos];
+                node.value += prices_[pos];
+                ++node.count;
+                node.taken.set(pos);
+                continue;
+            }
+        }
+        descend = false;
+        while (!descend && !path.empty()) {
+            auto& frame = path.back();
+            if (frame.in) {
+                frame.in = false;
+                node.taken.reset(frame.pos);
+                --node.count;
+                node.value -= prices_[frame.pos];
+                node.weight -= weights_[frame.pos];
+            }
+            if (frame.out) {
+                frame.out = false;
+                descend = true;
+            } else {
+                path.pop_back();
+                --node.depth;
+            }
+        }
+    }
+}
+
+void BranchAndBound::record_(const Node& node) {
+    std::lock_guard lock(incumbent_mutex_);
+    if (node.value <= incumbent_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    auto& [best_cost, best_chromosome] = best_;
+    best_cost = node.value;
+    best_chromosome = PackedChromosome(weights_.size());
+    for (std::size_t pos = 0; pos < node.depth; ++pos) {
+        if (node.taken.test(pos)) {
+            best_chromosome.set(order_[pos]);
+        }
+    }
+    incumbent_.store(node.value, std::memory_order_relaxed);
+}
+
+std::ostream& BranchAndBound::print(std::ostream& os) const {
+    const auto& [best_cost, best_chromosome] = best_;
+    os << "Branch and bound best cost: " << best_cost << (optimal_ ? " (optimal)" : " (time budget reached)") << '\n';
+    os << "Branch and bound best chromosome: ";
+    for (std::size_t gene = 0; gene < best_chromosome.num_genes(); ++gene) {
+        os << (best_chromosome.test(gene) ? "In " : "Out ");
+    }
+    os << '\n';
+    return os;
+}
@@ -0,0 +1,118 @@
+#ifndef PROJECT_BRANCHANDBOUND_H
+#define PROJECT_BRANCHANDBOUND_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <utility>  // std::pair
+#include <vector>
+
+#include "Knapsack.h"
+
+// Exact branch-and-bound solver for 0-1 knapsacks. Items are branched on in descending price/weight order (item In
+// first) and a node is pruned when its LP relaxation bound - the fractional knapsack bound, tightened by the item
+// limit - cannot beat the incumbent. The incumbent can be warm started from a GA solution (e.g.
+// GA::get_best_chromosome()); otherwise the greedy solution is used.
+// The search runs on several threads with work stealing: every thread explores its own subtrees depth first and
+// hands the other branch of a node to a shared deque whenever another thread is idle.
+// An optional time budget stops the search early, in which case the best solution found is returned without the
+// optimality certificate.
+class BranchAndBound {
+public:
+    using Chromosome = BinaryCostFunction::Chromosome;
+    using PackedChromosome = ::PackedChromosome;
+
+    BranchAndBound() = default;
+
+    void set_cf(const Knapsack* cf) noexcept;
+
+    // Sets the initial incumbent. Unfeasible incumbents are ignored. Reset by set_cf.
+    void set_incumbent(const Chromosome& chromosome);
+    void set_incumbent(PackedView chromosome);
+
+    // Stops the search after the given wall clock time - zero (the default) means no limit
+    void set_time_budget(std::chrono::milliseconds budget) noexcept { budget_ = budget; }
+
+    // Number of search threads - 0 uses one thread per hardware thread
+    void set_num_threads(std::size_t num_threads) noexcept { num_threads_ = num_threads; }
+
+    // Will throw if the cost function has not been set
+    void solve();
+
+    [[nodiscard]] std::size_t get_best_cost() const noexcept { return best_.first; }
+    [[nodiscard]] const PackedChromosome& get_best_chromosome() const noexcept { return best_.second; }
+
+    // True if the last solve explored the whole tree, i.e. the best cost is certified optimal
+    [[nodiscard]] bool is_optimal() const noexcept { return optimal_; }
+
+    // Number of nodes explored by the last solve
+    [[nodiscard]] std::size_t num_nodes() const noexcept { return num_nodes_; }
+
+    std::ostream& print(std::ostream& os) const;
+    friend std::ostream& operator<<(std::ostream& os, const BranchAndBound& bb) { return bb.print(os); }
+private:
+    // A subtree that has been handed over for another thread to explore. Items [0, depth) of the ratio order have
+    // been decided and the In ones are set in taken (indexed by ratio order position).
+    struct Node {
+        std::size_t depth = 0;
+        std::size_t weight = 0;
+        std::size_t value = 0;
+        std::size_t count = 0;
+        PackedChromosome taken;
+    };
+
+    // A position on the path from the explored node to the current one: the item decided there, whether it is
+    // currently In and whether its Out branch is still to be searched by this thread.
+    struct Frame {
+        std::size_t pos = 0;
+        bool in = false;
+        bool out = false;
+    };
+
+    // Per thread work deque. The owner pops from the back (depth first), thieves steal from the front (the oldest,
+    // largest subtrees).
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Node> nodes;
+    };
+
+    const Knapsack* cf_ = nullptr;
+    std::chrono::milliseconds budget_{0};
+    std::size_t num_threads_ = 1;
+
+    std::pair<std::size_t, PackedChromosome> best_;
+    bool optimal_ = false;
+    std::size_t num_nodes_ = 0;
+
+    // Search state - only valid during solve
+    std::vector<std::size_t> order_;            // Genes in descending ratio order
+    std::vector<std::size_t> weights_;          // Weights in ratio order
+    std::vector<std::size_t> prices_;           // Prices in ratio order
+    std::vector<std::size_t> weight_sums_;      // weight_sums_[i] = sum of weights_[0, i)
+    std::vector<std::size_t> price_sums_;       // price_sums_[i] = sum of prices_[0, i)
+    std::vector<std::size_t> max_prices_;       // max_prices_[i] = max of prices_[i, n)
+    std::vector<Worker> workers_;
+    std::atomic<std::size_t> incumbent_{0};     // Best cost so far - read without the lock for pruning
+    std::mutex incumbent_mutex_;                // Guards best_ updates
+    std::atomic<std::size_t> outstanding_{0};   // Nodes queued or being explored - the search ends at zero
+    std::atomic<std::size_t> idle_{0};          // Threads looking for work
+    std::atomic<std::size_t> nodes_{0};
+    std::atomic<bool> stop_{false};
+    std::chrono::steady_clock::time_point deadline_;
+
+    // LP bound of the node: its value plus the best fractional completion from item depth onwards
+    [[nodiscard]] std::size_t bound_(std::size_t depth, std::size_t weight, std::size_t value, std::size_t count) const noexcept;
+
+    // Thread body: explores nodes from its own deque, steals when it runs dry and returns once no work is left
+    void work_(std::size_t thread_no);
+    [[nodiscard]] bool next_node_(std::size_t thread_no, Node& node);
+
+    // Depth first search below the node, iterative over the thread's path stack so deep trees cannot overflow the call
+    // stack. The node is modified during the search and restored before returning unless the search is stopped.
+    void explore_(std::size_t thread_no, Node& node, std::vector<Frame>& path, std::size_t& local_nodes);
+
+    // Records the node as the new incumbent if it still beats it
+    void record_(const Node& node);
+};
+#endif //PROJECT_BRANCHANDBOUND_H
@@ -1,32 +1,162 @@
-#include <algorithm>    // std::next_permutation
+#include <algorithm>    // std::copy_n
 #include <ostream>
+#include <stdexcept>    // std::invalid_argument
+#include <thread>       // std::thread::hardware_concurrency
 
 #include "BruteForce.h"
+#include "ThreadPool.h"
 
 using std::invalid_argument; // If cost function has not been set
 
+namespace {
+    // Advances the packed chromosome to the next subset by treating its words as one wide binary counter.
+    // Returns false once every subset has been visited (the counter wraps around to the empty set).
+    bool next_subset(PackedChromosome& subset) noexcept {
+        auto* words = subset.data();
+        const std::size_t num_words = subset.num_words();
+        if (num_words == 0) {
+            return false;
+        }
+        for (std::size_t w = 0; w + 1 < num_words; ++w) {
+            if (++words[w] != 0) {
+                return true;
+            }
+        }
+        const auto tail = packed::tail_mask(subset.num_genes());
+        words[num_words - 1] = (words[num_words - 1] + 1) & tail;
+        return words[num_words - 1] != 0;
+    }
+}
+
 void BruteForce::set_cf(const BinaryCostFunction* cf) noexcept {
     cf_ = cf;
-    best_ = std::make_pair(0, Chromosome(cf->num_vars()));
+    best_ = std::make_pair(0, PackedChromosome(cf->num_vars()));
 }
 
 void BruteForce::solve() {
     if (!cf_) {
         throw invalid_argument("The cost function has not been set.");
     }
-    const std::size_t num_genes = cf_->num_vars();
-    std::vector<Gene> permutation(num_genes);
+    if (mode_ == Mode::GrayCode) {
+        if (!cf_->supports_totals()) {
+            throw invalid_argument("Gray code enumeration requires a cost function with running totals.");
+        }
+        solve_gray_code_();
+    } else {
+        solve_batch_();
+    }
+}
+
+void BruteForce::solve_batch_() {
+    PackedChromosome subset(cf_->num_vars());
     auto& [best_cost, best_chromosome] = best_;
-    // Compute the costs of every permutation
-    for (std::size_t index = num_genes; index > 0; --index) {
-        permutation[index-1] = Gene::In;
-        do {
-            const std::size_t cost = cf_->eval(permutation);
-            if (cost > best_cost) {
-                best_cost = cost;
-                best_chromosome = permutation;
+    // Compute the costs of every non-empty subset of genes. Subsets are generated into a buffer and handed to the
+    // cost function batch_size at a time.
+    constexpr std::size_t batch_size = 256;
+    const std::size_t stride = subset.num_words();
+    std::vector<packed::Word> batch(batch_size * stride);
+    std::vector<std::size_t> costs(batch_size);
+    bool more = true;
+    while (more) {
+        std::size_t num_subsets = 0;
+        while (num_subsets < batch_size && (more = next_subset(subset))) {
+            std::copy_n(subset.data(), stride, batch.data() + num_subsets * stride);
+            ++num_subsets;
+        }
+        cf_->eval_batch(batch.data(), stride, num_subsets, costs.data());
+        for (std::size_t i = 0; i < num_subsets; ++i) {
+            if (costs[i] > best_cost) {
+                best_cost = costs[i];
+                best_chromosome = PackedChromosome(PackedView(batch.data() + i * stride, subset.num_genes()));
             }
-        } while (std::next_permutation(std::begin(permutation), std::end(permutation)));
+        }
+    }
+}
+
+// The genes above the Gray code block are split into a fixed number of top genes, whose 2^split_bits assignments are
+// the independent tasks, and the genes in between, which each task assigns by a pruned depth first search.
+void BruteForce::solve_gray_code_() {
+    const std::size_t num_genes = cf_->num_vars();
+    const std::size_t gray_bits = std::min(num_genes, gray_bits_);
+    const std::size_t num_threads = num_threads_ ? num_threads_ : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t split_bits = 0;
+    while (split_bits < num_genes - gray_bits && (std::size_t{1} << split_bits) < num_threads * tasks_per_thread_) {
+        ++split_bits;
+    }
+    const std::size_t split_gene = num_genes - split_bits;
+
+    std::vector<Totals> gene_totals(num_genes);
+    for (std::size_t gene = 0; gene < num_genes; ++gene) {
+        gene_totals[gene] = cf_->gene_totals(gene);
+    }
+    std::vector<Search> searches(std::size_t{1} << split_bits);
+    ThreadPool pool(num_threads);
+    pool.parallel_for(searches.size(), [&](std::size_t task) {
+        auto& search = searches[task];
+        search.chromosome = PackedChromosome(num_genes);
+        search.best_chromosome = PackedChromosome(num_genes);
+        // The task number is the assignment of the top split_bits genes
+        for (std::size_t bit = 0; bit < split_bits; ++bit) {
+            if (task & (std::size_t{1} << bit)) {
+                search.chromosome.set(split_gene + bit);
+                search.totals += gene_totals[split_gene + bit];
+            }
+        }
+        if (cf_->feasible(search.totals)) {
+            search_(search, split_gene, gray_bits, gene_totals);
+        }
+    });
+    // Ties go to the lowest task so the result does not depend on the number of threads
+    auto& [best_cost, best_chromosome] = best_;
+    for (auto& search : searches) {
+        if (search.best_cost > best_cost) {
+            best_cost = search.best_cost;
+            best_chromosome = std::move(search.best_chromosome);
+        }
+    }
+}
+
+// Genes [next_gene, num_genes) are assigned. Tries gene next_gene - 1 Out and then In, pruning the In branch when it
+// breaks a constraint since adding genes below can never repair it.
+void BruteForce::search_(Search& search, std::size_t next_gene, std::size_t gray_bits,
+                         const std::vector<Totals>& gene_totals) const noexcept {
+    if (next_gene == gray_bits) {
+        gray_walk_(search, gray_bits, gene_totals);
+        return;
+    }
+    const std::size_t gene = next_gene - 1;
+    search_(search, gene, gray_bits, gene_totals);
+    search.chromosome.set(gene);
+    search.totals += gene_totals[gene];
+    if (cf_->feasible(search.totals)) {
+        search_(search, gene, gray_bits, gene_totals);
+    }
+    search.chromosome.reset(gene);
+    search.totals -= gene_totals[gene];
+}
+
+// Visits all 2^gray_bits assignments of the low genes. Step k flips gene ctz(k), so each subset costs one O(1) totals
+// update. The walk ends on the code with only the top bit set, which is cleared again before returning.
+void BruteForce::gray_walk_(Search& search, std::size_t gray_bits, const std::vector<Totals>& gene_totals) const noexcept {
+    auto* low_word = search.chromosome.data();
+    const auto record = [&]() {
+        if (const std::size_t cost = cf_->eval_totals(search.totals); cost > search.best_cost) {
+            search.best_cost = cost;
+            search.best_chromosome = search.chromosome;
+        }
+    };
+    record();
+    const std::size_t num_steps = std::size_t{1} << gray_bits;
+    for (std::size_t step = 1; step < num_steps; ++step) {
+        const std::size_t gene = packed::lowest_bit(step);
+        const auto mask = packed::bit_mask(gene);
+        low_word[0] ^= mask;
+        (low_word[0] & mask) ? search.totals += gene_totals[gene] : search.totals -= gene_totals[gene];
+        record();
+    }
+    if (gray_bits > 0) {
+        low_word[0] ^= packed::bit_mask(gray_bits - 1);
+        search.totals -= gene_totals[gray_bits - 1];
     }
 }
 
@@ -34,8 +164,8 @@ std::ostream& BruteForce::print(std::ostream& os) const {
     const auto& [best_cost, best_chromosome] = best_;
     os << "Brute force best cost: " << best_cost << '\n';
     os << "Brute force best chromosome: ";
-    for (const auto& gene : best_chromosome) {
-        os << ((gene == Gene::Out) ? "Out " : "In ");
+    for (std::size_t gene = 0; gene < best_chromosome.num_genes(); ++gene) {
+        os << (best_chromosome.test(gene) ? "In " : "Out ");
     }
     os << '\n';
     return os;
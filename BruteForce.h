@@ -1,23 +1,68 @@
 #ifndef PROJECT_BRUTEFORCE_H
 #define PROJECT_BRUTEFORCE_H
 
+#include <vector>
+
 #include "BinaryCostFunction.h"
 
+// Exhaustive solver. Two enumeration modes are available:
+//  - Batch (the default) generates every subset and evaluates them through the cost function's eval_batch. Works with
+//    any cost function.
+//  - GrayCode needs a cost function with running totals. The low genes of each subset are walked in Gray code order so
+//    every step flips a single gene and updates the totals in O(1). The high genes are assigned by a depth-first search
+//    that cuts off branches that are already unfeasible (over capacity or over the item limit), and the top of that
+//    search is split into independent prefix ranges that are spread over the worker threads.
 class BruteForce {
 public:
     using Gene = BinaryCostFunction::Gene;
     using Chromosome = BinaryCostFunction::Chromosome;
+    using PackedChromosome = ::PackedChromosome;
+    using Totals = BinaryCostFunction::Totals;
+
+    enum class Mode { Batch, GrayCode };
 
     BruteForce() = default;
 
     void set_cf(const BinaryCostFunction* cf) noexcept;
 
+    // Selects the enumeration mode. Will throw from solve if GrayCode is used with a cost function without totals.
+    void set_mode(Mode mode) noexcept { mode_ = mode; }
+
+    // Number of threads used by the GrayCode mode - 0 uses one thread per hardware thread
+    void set_num_threads(std::size_t num_threads) noexcept { num_threads_ = num_threads; }
+
     void solve();
 
+    // Returns the best cost and chromosome found by the last solve
+    [[nodiscard]] std::size_t get_best_cost() const noexcept { return best_.first; }
+    [[nodiscard]] const PackedChromosome& get_best_chromosome() const noexcept { return best_.second; }
+
     std::ostream& print(std::ostream& os) const;
     friend std::ostream& operator<<(std::ostream& os, const BruteForce& bf) { return bf.print(os); }
 private:
+    // Genes [0, gray_bits_) are walked in Gray code order below every feasible assignment of the other genes
+    static constexpr std::size_t gray_bits_ = 16;
+    // The search is split into about this many prefix ranges per thread for load balancing
+    static constexpr std::size_t tasks_per_thread_ = 16;
+
     const BinaryCostFunction* cf_ = nullptr;
-    std::pair<std::size_t, Chromosome> best_;
+    std::pair<std::size_t, PackedChromosome> best_;
+    Mode mode_ = Mode::Batch;
+    std::size_t num_threads_ = 1;
+
+    void solve_batch_();
+    void solve_gray_code_();
+
+    // Search state of one prefix range in GrayCode mode
+    struct Search {
+        PackedChromosome chromosome;    // Current assignment
+        Totals totals;                  // Totals of the current assignment
+        std::size_t best_cost = 0;
+        PackedChromosome best_chromosome;
+    };
+
+    // Assigns genes [gray_bits, gene) depth first, pruning unfeasible branches, and then walks the Gray code
+    void search_(Search& search, std::size_t gene, std::size_t gray_bits, const std::vector<Totals>& gene_totals) const noexcept;
+    void gray_walk_(Search& search, std::size_t gray_bits, const std::vector<Totals>& gene_totals) const noexcept;
 };
 #endif //PROJECT_BRUTEFORCE_H
\ No newline at end of file
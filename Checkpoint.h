@@ -0,0 +1,42 @@
+#ifndef PROJECT_CHECKPOINT_H
+#define PROJECT_CHECKPOINT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Binary GA checkpoint layout, written by GA::save_checkpoint and read by GA::load_checkpoint. All fields are native
+// endian 64-bit values: the header, then the main rng state, the state of each offspring stream, the ranks, the
+// costs, the best cost of each generation so far and the packed genes (pop_size x words per chromosome, row-major).
+// Running totals are not stored - they are recomputed from the genes on load.
+namespace checkpoint_file {
+    constexpr char magic[8] = {'G', 'A', 'C', 'H', 'E', 'C', 'K', 'P'};
+    constexpr std::uint32_t version = 1;
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t header_size;
+        std::uint64_t num_genes;
+        std::uint64_t pop_size;
+        std::uint64_t num_elite;
+        std::uint64_t t_size;
+        std::uint64_t num_mutations;
+        std::uint64_t mode;                 // GA::Mode
+        std::uint64_t num_replacements;
+        std::uint64_t num_streams;
+        std::uint64_t num_best_costs;
+        std::uint64_t reserved;             // Pads the header to 96 bytes
+    };
+    static_assert(sizeof(Header) == 96, "The checkpoint header is 96 bytes");
+    static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "The arrays are written as std::size_t directly");
+
+    // Words of rng state per generator
+    constexpr std::size_t state_words = 4;
+
+    // Total file size for the given header
+    [[nodiscard]] constexpr std::size_t file_size(const Header& header, std::size_t words_per_chromosome) noexcept {
+        return sizeof(Header) + sizeof(std::uint64_t) * (state_words * (1 + header.num_streams) + 2 * header.pop_size +
+                                                         header.num_best_costs + header.pop_size * words_per_chromosome);
+    }
+}
+#endif //PROJECT_CHECKPOINT_H
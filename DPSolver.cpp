@@ -0,0 +1,130 @@
+#include <ostream>
+#include <stdexcept>    // std::invalid_argument
+
+#include "DPSolver.h"
+
+using std::invalid_argument; // If cost function has not been set
+
+void DPSolver::set_cf(const Knapsack* cf) noexcept {
+    cf_ = cf;
+    best_ = std::make_pair(0, PackedChromosome(cf->num_vars()));
+}
+
+void DPSolver::solve() {
+    if (!cf_) {
+        throw invalid_argument("The cost function has not been set.");
+    }
+    best_ = std::make_pair(0, PackedChromosome(cf_->num_vars()));
+    if (cf_->max_items() >= cf_->num_vars()) {
+        solve_capacity_();
+    } else {
+        solve_cardinality_();
+    }
+    // The tables are only needed during the solve
+    table_ = {};
+    taken_ = {};
+}
+
+// table_[w] is the best cost using at most w capacity. Capacities are visited in decreasing order so every item is
+// used at most once per pass.
+void DPSolver::solve_capacity_() {
+    const std::size_t num_genes = cf_->num_vars();
+    const std::size_t capacity = cf_->max_weight();
+    const std::size_t row_words = packed::num_words(capacity + 1);
+    const auto* weights = cf_->weights();
+    const auto* prices = cf_->prices();
+    table_.assign(capacity + 1, 0);
+    if (backtrack_) {
+        taken_.assign(num_genes * row_words, 0);
+    }
+    for (std::size_t gene = 0; gene < num_genes; ++gene) {
+        const std::size_t weight = weights[gene];
+        const std::size_t price = prices[gene];
+        if (weight > capacity) {
+            continue;
+        }
+        auto* taken = backtrack_ ? taken_.data() + gene * row_words : nullptr;
+        for (std::size_t w = capacity + 1; w-- > weight;) {
+            if (const std::size_t with_item = table_[w - weight] + price; with_item > table_[w]) {
+                table_[w] = with_item;
+                if (taken) {
+                    taken[packed::word_index(w)] |= packed::bit_mask(w);
+                }
+            }
+        }
+    }
+    auto& [best_cost, best_chromosome] = best_;
+    best_cost = table_[capacity];
+    if (backtrack_) {
+        std::size_t w = capacity;
+        for (std::size_t gene = num_genes; gene-- > 0;) {
+            if (taken_[gene * row_words + packed::word_index(w)] & packed::bit_mask(w)) {
+                best_chromosome.set(gene);
+                w -= weights[gene];
+            }
+        }
+    }
+}
+
+// table_[c * (capacity + 1) + w] is the best cost using at most c items and at most w capacity.
+void DPSolver::solve_cardinality_() {
+    const std::size_t num_genes = cf_->num_vars();
+    const std::size_t capacity = cf_->max_weight();
+    const std::size_t max_items = cf_->max_items();
+    const std::size_t row = capacity + 1;
+    const std::size_t layer_words = packed::num_words((max_items + 1) * row);
+    const auto* weights = cf_->weights();
+    const auto* prices = cf_->prices();
+    table_.assign((max_items + 1) * row, 0);
+    if (backtrack_) {
+        taken_.assign(num_genes * layer_words, 0);
+    }
+    for (std::size_t gene = 0; gene < num_genes; ++gene) {
+        const std::size_t weight = weights[gene];
+        const std::size_t price = prices[gene];
+        if (weight > capacity) {
+            continue;
+        }
+        auto* taken = backtrack_ ? taken_.data() + gene * layer_words : nullptr;
+        for (std::size_t count = max_items; count > 0; --count) {
+            const auto* fewer = table_.data() + (count - 1) * row;
+            auto* current = table_.data() + count * row;
+            for (std::size_t w = capacity + 1; w-- > weight;) {
+                if (const std::size_t with_item = fewer[w - weight] + price; with_item > current[w]) {
+                    current[w] = with_item;
+                    if (taken) {
+                        const std::size_t cell = count * row + w;
+                        taken[packed::word_index(cell)] |= packed::bit_mask(cell);
+                    }
+                }
+            }
+        }
+    }
+    auto& [best_cost, best_chromosome] = best_;
+    best_cost = table_[max_items * row + capacity];
+    if (backtrack_) {
+        std::size_t w = capacity;
+        std::size_t count = max_items;
+        for (std::size_t gene = num_genes; gene-- > 0 && count > 0;) {
+            const std::size_t cell = count * row + w;
+            if (taken_[gene * layer_words + packed::word_index(cell)] & packed::bit_mask(cell)) {
+                best_chromosome.set(gene);
+                w -= weights[gene];
+                --count;
+            }
+        }
+    }
+}
+
+std::ostream& DPSolver::print(std::ostream& os) const {
+    const auto& [best_cost, best_chromosome] = best_;
+    os << "DP best cost: " << best_cost << '\n';
+    if (backtrack_) {
+        os << "DP best chromosome: ";
+        for (std::size_t gene = 0; gene < best_chromosome.num_genes(); ++gene) {
+            os << (best_chromosome.test(gene) ? "In " : "Out ");
+        }
+        os << '\n';
+    }
+    return os;
+}
@@ -0,0 +1,46 @@
+#ifndef PROJECT_DPSOLVER_H
+#define PROJECT_DPSOLVER_H
+
+#include <vector>
+
+#include "Knapsack.h"
+
+// Exact pseudo-polynomial solver for 0-1 knapsacks - a fast alternative to BruteForce when the capacity is moderate.
+// Dynamic programming over capacity with a rolling 1-D table (O(W) memory for the costs). When the knapsack's item
+// limit is binding a cardinality dimension is added (O(K * W)). With backtracking enabled (the default) one bit per
+// item and table cell records whether the item was taken, which allows the optimal chromosome to be rebuilt using
+// O(n * W / 64) words (O(n * K * W / 64) with the item limit); without it only the optimal cost is found.
+class DPSolver {
+public:
+    using PackedChromosome = ::PackedChromosome;
+
+    DPSolver() = default;
+
+    void set_cf(const Knapsack* cf) noexcept;
+
+    // Enables or disables rebuilding the optimal chromosome
+    void set_backtrack(bool backtrack) noexcept { backtrack_ = backtrack; }
+
+    void solve();
+
+    // Returns the optimal cost and, if backtracking is enabled, the optimal chromosome
+    [[nodiscard]] std::size_t get_best_cost() const noexcept { return best_.first; }
+    [[nodiscard]] const PackedChromosome& get_best_chromosome() const noexcept { return best_.second; }
+
+    std::ostream& print(std::ostream& os) const;
+    friend std::ostream& operator<<(std::ostream& os, const DPSolver& dp) { return dp.print(os); }
+private:
+    const Knapsack* cf_ = nullptr;
+    bool backtrack_ = true;
+    std::pair<std::size_t, PackedChromosome> best_;
+
+    std::vector<std::size_t> table_;    // Best cost for each (item count,) capacity cell
+    std::vector<packed::Word> taken_;   // Backtrack bits - one row of cells per item
+
+    // Capacity only DP - the item limit is not binding
+    void solve_capacity_();
+
+    // DP over item count and capacity
+    void solve_cardinality_();
+};
+#endif //PROJECT_DPSOLVER_H
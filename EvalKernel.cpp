@@ -0,0 +1,273 @@
+#include "EvalKernel.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GA_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace eval_kernel {
+namespace {
+    // Portable version - visits only the set bits of each word
+    Totals sum_words_scalar(const Word* words, std::size_t num_words,
+                            const std::size_t* weights, const std::size_t* prices) noexcept {
+        Totals totals;
+        for (std::size_t w = 0; w < num_words; ++w) {
+            const std::size_t base = w * packed::bits_per_word;
+            for (auto word = words[w]; word; word &= word - 1) {
+                const std::size_t gene = base + packed::lowest_bit(word);
+                totals.weight += weights[gene];
+                totals.value += prices[gene];
+            }
+            totals.count += packed::popcount(words[w]);
+        }
+        return totals;
+    }
+
+#ifdef GA_X86_KERNELS
+    // AVX2: 4 genes per step. Each nibble of the word is broadcast and compared against the lane bits {1, 2, 4, 8}
+    // to build a lane mask, which selects the weights and prices that are accumulated.
+    __attribute__((target("avx2")))
+    Totals sum_words_avx2(const Word* words, std::size_t num_words,
+                          const std::size_t* weights, const std::size_t* prices) noexcept {
+        const __m256i lane_bits = _mm256_set_epi64x(8, 4, 2, 1);
+        __m256i weight_acc = _mm256_setzero_si256();
+        __m256i price_acc = _mm256_setzero_si256();
+        std::size_t count = 0;
+        for (std::size_t w = 0; w < num_words; ++w) {
+            const Word word = words[w];
+            if (word == 0) {
+                continue;
+            }
+            count += packed::popcount(word);
+            const std::size_t base = w * packed::bits_per_word;
+            for (std::size_t nibble = 0; nibble < packed::bits_per_word / 4; ++nibble) {
+                const auto bits = static_cast<long long>((word >> (nibble * 4)) & 0xF);
+                if (bits == 0) {
+                    continue;
+                }
+                const __m256i mask = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(bits), lane_bits), lane_bits);
+                const auto* weight_ptr = reinterpret_cast<const __m256i*>(weights + base + nibble * 4);
+                const auto* price_ptr = reinterpret_cast<const __m256i*>(prices + base + nibble * 4);
+                weight_acc = _mm256_add_epi64(weight_acc, _mm256_and_si256(mask, _mm256_loadu_si256(weight_ptr)));
+                price_acc = _mm256_add_epi64(price_acc, _mm256_and_si256(mask, _mm256_loadu_si256(price_ptr)));
+            }
+        }
+        alignas(32) std::size_t weight_lanes[4];
+        alignas(32) std::size_t price_lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(weight_lanes), weight_acc);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(price_lanes), price_acc);
+        return {weight_lanes[0] + weight_lanes[1] + weight_lanes[2] + weight_lanes[3],
+                price_lanes[0] + price_lanes[1] + price_lanes[2] + price_lanes[3], count};
+    }
+
+    // AVX-512: 8 genes per step. Each byte of the word is used directly as the load mask.
+    __attribute__((target("avx512f")))
+    Totals sum_words_avx512(const Word* words, std::size_t num_words,
+                            const std::size_t* weights, const std::size_t* prices) noexcept {
+        __m512i weight_acc = _mm512_setzero_si512();
+        __m512i price_acc = _mm512_setzero_si512();
+        std::size_t count = 0;
+        for (std::size_t w = 0; w < num_words; ++w) {
+            const Word word = words[w];
+            if (word == 0) {
+                continue;
+            }
+            count += packed::popcount(word);
+            const std::size_t base = w * packed::bits_per_word;
+            for (std::size_t byte = 0; byte < packed::bits_per_word / 8; ++byte) {
+                const auto mask = static_cast<__mmask8>((word >> (byte * 8)) & 0xFF);
+                if (mask == 0) {
+                    continue;
+                }
+                weight_acc = _mm512_add_epi64(weight_acc, _mm512_maskz_loadu_epi64(mask, weights + base + byte * 8));
+                price_acc = _mm512_add_epi64(price_acc, _mm512_maskz_loadu_epi64(mask, prices + base + byte * 8));
+            }
+        }
+        alignas(64) std::size_t weight_lanes[8];
+        alignas(64) std::size_t price_lanes[8];
+        _mm512_store_si512(weight_lanes, weight_acc);
+        _mm512_store_si512(price_lanes, price_acc);
+        Totals totals{0, 0, count};
+        for (std::size_t lane = 0; lane < 8; ++lane) {
+            totals.weight += weight_lanes[lane];
+            totals.value += price_lanes[lane];
+        }
+        return totals;
+    }
+#endif
+
+    std::size_t add_columns_scalar(const Word* words, std::size_t num_words, const std::size_t* columns,
+                                   std::size_t stride, const std::size_t* prices, std::size_t* load) noexcept {
+        std::size_t value = 0;
+        for (std::size_t w = 0; w < num_words; ++w) {
+            const std::size_t base = w * packed::bits_per_word;
+            for (auto word = words[w]; word; word &= word - 1) {
+                const std::size_t gene = base + packed::lowest_bit(word);
+                const std::size_t* column = columns + gene * stride;
+                for (std::size_t dim = 0; dim < stride; ++dim) {
+                    load[dim] += column[dim];
+                }
+                value += prices[gene];
+            }
+        }
+        return value;
+    }
+
+    std::size_t first_violation_scalar(const std::size_t* load, const std::size_t* capacities, std::size_t stride) noexcept {
+        for (std::size_t dim = 0; dim < stride; ++dim) {
+            if (load[dim] > capacities[dim]) {
+                return dim;
+            }
+        }
+        return stride;
+    }
+
+    bool fits_scalar(const std::size_t* load, const std::size_t* column, const std::size_t* capacities,
+                     std::size_t stride) noexcept {
+        for (std::size_t dim = 0; dim < stride; ++dim) {
+            if (load[dim] + column[dim] > capacities[dim]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+#ifdef GA_X86_KERNELS
+    // AVX2 has no unsigned 64-bit compare: flipping the sign bits of both sides turns it into a signed one
+    __attribute__((target("avx2")))
+    inline __m256i greater_epu64(__m256i lhs, __m256i rhs) noexcept {
+        const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(Word{1} << 63));
+        return _mm256_cmpgt_epi64(_mm256_xor_si256(lhs, sign), _mm256_xor_si256(rhs, sign));
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t add_columns_avx2(const Word* words, std::size_t num_words, const std::size_t* columns,
+                                 std::size_t stride, const std::size_t* prices, std::size_t* load) noexcept {
+        std::size_t value = 0;
+        for (std::size_t w = 0; w < num_words; ++w) {
+            const std::size_t base = w * packed::bits_per_word;
+            for (auto word = words[w]; word; word &= word - 1) {
+                const std::size_t gene = base + packed::lowest_bit(word);
+                const std::size_t* column = columns + gene * stride;
+                for (std::size_t dim = 0; dim < stride; dim += column_align) {
+                    auto* load_ptr = reinterpret_cast<__m256i*>(load + dim);
+                    const auto* column_ptr = reinterpret_cast<const __m256i*>(column + dim);
+                    _mm256_storeu_si256(load_ptr, _mm256_add_epi64(_mm256_loadu_si256(load_ptr), _mm256_loadu_si256(column_ptr)));
+                }
+                value += prices[gene];
+            }
+        }
+        return value;
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t first_violation_avx2(const std::size_t* load, const std::size_t* capacities, std::size_t stride) noexcept {
+        for (std::size_t dim = 0; dim < stride; dim += column_align) {
+            const __m256i over = greater_epu64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(load + dim)),
+                                               _mm256_loadu_si256(reinterpret_cast<const __m256i*>(capacities + dim)));
+            if (const int lanes = _mm256_movemask_pd(_mm256_castsi256_pd(over)); lanes != 0) {
+                return dim + packed::lowest_bit(static_cast<Word>(lanes));
+            }
+        }
+        return stride;
+    }
+
+    __attribute__((target("avx2")))
+    bool fits_avx2(const std::size_t* load, const std::size_t* column, const std::size_t* capacities,
+                   std::size_t stride) noexcept {
+        for (std::size_t dim = 0; dim < stride; dim += column_align) {
+            const __m256i sum = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(load + dim)),
+                                                 _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + dim)));
+            const __m256i over = greater_epu64(sum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(capacities + dim)));
+            if (!_mm256_testz_si256(over, over)) {
+                return false;
+            }
+        }
+        return true;
+    }
+#endif
+
+    using Kernel = Totals (*)(const Word*, std::size_t, const std::size_t*, const std::size_t*) noexcept;
+    using AddColumns = std::size_t (*)(const Word*, std::size_t, const std::size_t*, std::size_t, const std::size_t*,
+                                       std::size_t*) noexcept;
+    using FirstViolation = std::size_t (*)(const std::size_t*, const std::size_t*, std::size_t) noexcept;
+    using Fits = bool (*)(const std::size_t*, const std::size_t*, const std::size_t*, std::size_t) noexcept;
+
+    Kernel kernel_for(Isa isa) noexcept {
+        switch (isa) {
+#ifdef GA_X86_KERNELS
+            case Isa::Avx512: return &sum_words_avx512;
+            case Isa::Avx2: return &sum_words_avx2;
+#endif
+            default: return &sum_words_scalar;
+        }
+    }
+
+    struct ColumnKernels {
+        AddColumns add_columns;
+        FirstViolation first_violation;
+        Fits fits;
+    };
+
+    // The multi-dimensional kernels only come in scalar and AVX2 versions
+    ColumnKernels column_kernels() noexcept {
+#ifdef GA_X86_KERNELS
+        if (supported(Isa::Avx2)) {
+            return {&add_columns_avx2, &first_violation_avx2, &fits_avx2};
+        }
+#endif
+        return {&add_columns_scalar, &first_violation_scalar, &fits_scalar};
+    }
+}
+
+bool supported(Isa isa) noexcept {
+    switch (isa) {
+#ifdef GA_X86_KERNELS
+        case Isa::Avx512: return __builtin_cpu_supports("avx512f");
+        case Isa::Avx2: return __builtin_cpu_supports("avx2");
+#endif
+        case Isa::Scalar: return true;
+        default: return false;
+    }
+}
+
+Isa best_isa() noexcept {
+    // Resolved once - the CPU does not change under us
+    static const Isa isa = supported(Isa::Avx512) ? Isa::Avx512 : supported(Isa::Avx2) ? Isa::Avx2 : Isa::Scalar;
+    return isa;
+}
+
+const char* name(Isa isa) noexcept {
+    switch (isa) {
+        case Isa::Avx512: return "avx512";
+        case Isa::Avx2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+Totals sum_words(const Word* words, std::size_t num_words, const std::size_t* weights, const std::size_t* prices) noexcept {
+    static const Kernel kernel = kernel_for(best_isa());
+    return kernel(words, num_words, weights, prices);
+}
+
+Totals sum_words(Isa isa, const Word* words, std::size_t num_words,
+                 const std::size_t* weights, const std::size_t* prices) noexcept {
+    return kernel_for(isa)(words, num_words, weights, prices);
+}
+
+std::size_t add_columns(const Word* words, std::size_t num_words, const std::size_t* columns, std::size_t stride,
+                        const std::size_t* prices, std::size_t* load) noexcept {
+    static const ColumnKernels kernels = column_kernels();
+    return kernels.add_columns(words, num_words, columns, stride, prices, load);
+}
+
+std::size_t first_violation(const std::size_t* load, const std::size_t* capacities, std::size_t stride) noexcept {
+    static const ColumnKernels kernels = column_kernels();
+    return kernels.first_violation(load, capacities, stride);
+}
+
+bool fits(const std::size_t* load, const std::size_t* column, const std::size_t* capacities, std::size_t stride) noexcept {
+    static const ColumnKernels kernels = column_kernels();
+    return kernels.fits(load, column, capacities, stride);
+}
+}
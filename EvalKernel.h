@@ -0,0 +1,54 @@
+#ifndef PROJECT_EVALKERNEL_H
+#define PROJECT_EVALKERNEL_H
+
+#include "BinaryCostFunction.h"
+
+// Masked dot product kernels for knapsack style cost functions. Given packed chromosome words and the matching
+// contiguous weight and price arrays, they compute the total weight, total price and number of In genes.
+// AVX2 and AVX-512 versions are compiled with function-level target attributes and selected at runtime from the
+// CPU's capabilities, with a portable scalar fallback, so no special compiler flags are needed.
+namespace eval_kernel {
+    using Totals = BinaryCostFunction::Totals;
+    using Word = packed::Word;
+
+    enum class Isa { Scalar, Avx2, Avx512 };
+
+    // The fastest instruction set supported by both the build and the running CPU
+    [[nodiscard]] Isa best_isa() noexcept;
+
+    // Returns true if the given instruction set can be used on this machine
+    [[nodiscard]] bool supported(Isa isa) noexcept;
+
+    // Printable name of the instruction set
+    [[nodiscard]] const char* name(Isa isa) noexcept;
+
+    // Totals of the set bits of words[0, num_words). Bit b of words[w] selects weights[w * 64 + b] and
+    // prices[w * 64 + b], so both arrays must hold num_words * 64 entries. Uses best_isa().
+    [[nodiscard]] Totals sum_words(const Word* words, std::size_t num_words,
+                                   const std::size_t* weights, const std::size_t* prices) noexcept;
+
+    // Same as above but with an explicitly chosen instruction set, which must be supported (for benchmarks).
+    [[nodiscard]] Totals sum_words(Isa isa, const Word* words, std::size_t num_words,
+                                   const std::size_t* weights, const std::size_t* prices) noexcept;
+
+    // Multi-dimensional knapsack kernels over a column-major constraint matrix: column g (stride entries starting at
+    // columns + g * stride) holds the resource weights of gene g. stride must be a multiple of column_align, with
+    // the padding entries zero in the columns and the maximum std::size_t in the capacities so they never bind.
+    // A column is only a few vectors wide, so these use AVX2 on AVX2 and AVX-512 machines alike.
+    constexpr std::size_t column_align = 4;
+
+    // Adds the column of every set bit of words[0, num_words) to load[0, stride) and returns the sum of their prices.
+    // Bit b of words[w] is gene w * 64 + b.
+    std::size_t add_columns(const Word* words, std::size_t num_words, const std::size_t* columns, std::size_t stride,
+                            const std::size_t* prices, std::size_t* load) noexcept;
+
+    // Index of the first dimension where load exceeds the capacity, or stride if there is none. Exits at the first
+    // vector with a violation.
+    [[nodiscard]] std::size_t first_violation(const std::size_t* load, const std::size_t* capacities,
+                                              std::size_t stride) noexcept;
+
+    // Returns true if load + column is within the capacities in every dimension
+    [[nodiscard]] bool fits(const std::size_t* load, const std::size_t* column, const std::size_t* capacities,
+                            std::size_t stride) noexcept;
+}
+#endif //PROJECT_EVALKERNEL_H
@@ -0,0 +1,86 @@
+#include <algorithm>    // std::copy_n, std::equal, std::fill
+
+#include "FitnessCache.h"
+
+FitnessCache::FitnessCache(std::size_t capacity) {
+    std::size_t size = probe_window_;
+    while (size < capacity) {
+        size *= 2;
+    }
+    slots_.resize(size);
+    mask_ = size - 1;
+}
+
+void FitnessCache::set_num_words(std::size_t num_words) {
+    if (num_words != num_words_) {
+        num_words_ = num_words;
+        keys_.assign(slots_.size() * num_words_, Word{0});
+        clear();
+    }
+}
+
+void FitnessCache::clear() noexcept {
+    std::fill(std::begin(slots_), std::end(slots_), Slot{});
+}
+
+std::uint64_t FitnessCache::hash(const Word* words, std::size_t num_words) noexcept {
+    std::uint64_t h = 0x9E3779B97F4A7C15ull ^ num_words;
+    for (std::size_t w = 0; w < num_words; ++w) {
+        h = (h ^ words[w]) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 31;
+    }
+    h *= 0x94D049BB133111EBull;
+    return h ^ (h >> 29);
+}
+
+bool FitnessCache::matches_(std::size_t slot, std::uint64_t hash, const Word* words) const noexcept {
+    return slots_[slot].hash == hash && std::equal(words, words + num_words_, keys_.data() + slot * num_words_);
+}
+
+bool FitnessCache::find(PackedView chromosome, std::size_t& cost) noexcept {
+    const std::uint64_t h = hash(chromosome.words(), num_words_);
+    for (std::size_t probe = 0; probe < probe_window_; ++probe) {
+        const std::size_t slot = (h + probe) & mask_;
+        if (!slots_[slot].used) {
+            break;
+        }
+        if (matches_(slot, h, chromosome.words())) {
+            slots_[slot].referenced = true;
+            cost = slots_[slot].cost;
+            ++hits_;
+            return true;
+        }
+    }
+    ++misses_;
+    return false;
+}
+
+// Takes the first empty slot of the window, or updates the chromosome's entry if it is already there. A full window
+// gets one CLOCK sweep: referenced entries lose their bit and the first unreferenced one is replaced - if all of them
+// were referenced the sweep starts over and replaces the first slot.
+void FitnessCache::insert(PackedView chromosome, std::size_t cost) noexcept {
+    const std::uint64_t h = hash(chromosome.words(), num_words_);
+    std::size_t target = h & mask_;
+    bool found = false;
+    for (std::size_t probe = 0; probe < probe_window_; ++probe) {
+        const std::size_t slot = (h + probe) & mask_;
+        if (!slots_[slot].used || matches_(slot, h, chromosome.words())) {
+            target = slot;
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        for (std::size_t probe = 0; probe < probe_window_; ++probe) {
+            const std::size_t slot = (h + probe) & mask_;
+            if (!slots_[slot].referenced) {
+                target = slot;
+                break;
+            }
+            slots_[slot].referenced = false;
+        }
+        ++evictions_;
+    }
+    slots_[target] = Slot{h, cost, true, false};
+    std::copy_n(chromosome.words(), num_words_, key_(target));
+}
@@ -0,0 +1,67 @@
+#ifndef PROJECT_FITNESSCACHE_H
+#define PROJECT_FITNESSCACHE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "PackedChromosome.h"
+
+// Bounded memo of chromosome costs for expensive cost functions. An open addressing table keyed by a hash of the
+// packed words: a chromosome may live in any of probe_window_ consecutive slots starting at its hash, and the full
+// words are stored so hash collisions never return a wrong cost. Entries are never deleted, only replaced, so a
+// lookup can stop at the first empty slot.
+// Eviction is CLOCK (second chance) within the probe window: every hit sets the entry's referenced bit, and an insert
+// into a full window clears referenced bits as it sweeps and replaces the first entry that had none.
+// The cache is not thread safe - the GA only touches it from the calling thread.
+class FitnessCache {
+public:
+    using Word = packed::Word;
+
+    // Creates a cache with room for at least capacity chromosomes (rounded up to a power of two)
+    explicit FitnessCache(std::size_t capacity);
+
+    // Sets the number of words per chromosome. Clears the cache if it changes. Allocates the key storage.
+    void set_num_words(std::size_t num_words);
+
+    // Removes every entry. The counters are kept.
+    void clear() noexcept;
+
+    // Looks up the chromosome. Returns true and sets cost on a hit.
+    [[nodiscard]] bool find(PackedView chromosome, std::size_t& cost) noexcept;
+
+    // Stores the chromosome's cost, evicting an entry of its probe window if the window is full
+    void insert(PackedView chromosome, std::size_t cost) noexcept;
+
+    // Counters for tuning the capacity
+    [[nodiscard]] std::size_t hits() const noexcept { return hits_; }
+    [[nodiscard]] std::size_t misses() const noexcept { return misses_; }
+    [[nodiscard]] std::size_t evictions() const noexcept { return evictions_; }
+    void reset_counters() noexcept { hits_ = misses_ = evictions_ = 0; }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return slots_.size(); }
+
+    // 64-bit multiply-xorshift hash of a run of packed words
+    [[nodiscard]] static std::uint64_t hash(const Word* words, std::size_t num_words) noexcept;
+private:
+    static constexpr std::size_t probe_window_ = 8;
+
+    struct Slot {
+        std::uint64_t hash = 0;
+        std::size_t cost = 0;
+        bool used = false;
+        bool referenced = false;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<Word> keys_;    // Words of the chromosome in slot i start at i * num_words_
+    std::size_t mask_ = 0;      // slots_.size() - 1
+    std::size_t num_words_ = 0;
+
+    std::size_t hits_ = 0;
+    std::size_t misses_ = 0;
+    std::size_t evictions_ = 0;
+
+    [[nodiscard]] Word* key_(std::size_t slot) noexcept { return keys_.data() + slot * num_words_; }
+    [[nodiscard]] bool matches_(std::size_t slot, std::uint64_t hash, const Word* words) const noexcept;
+};
+#endif //PROJECT_FITNESSCACHE_H
@@ -1,117 +1,191 @@
 #ifndef PROJECT_GA_H
 #define PROJECT_GA_H
 
-#include <unordered_map>    // Could use a vector to store the population but it might be messier
-#include <random>           // Rng generator & distribution
+#include <memory>           // The engine behind the facade
 #include <string>           // For export filename
 
-#include "BinaryCostFunction.h"
+#include "BasicGA.h"
 
-// This GA solves binary cost functions where gene values are represented by 0 or 1 (Out or In). It is currently
+// This GA solves binary cost functions where gene values are represented by 0 or 1 (Out or In). By default it is
 // a generational implementation where all chromosomes are replaced every generation. Elite chromosomes, if specified,
-// will not be replaced or altered.
+// will not be replaced or altered. In steady state mode (see set_mode) each step instead breeds a few children that
+// replace the worst chromosomes.
+// GA is a type-erased facade over a BasicGA (see BasicGA.h for how the engine stores and evolves the population),
+// which fixes the cost function type and the selection, crossover, mutation and repair operators at compile time. A
+// default constructed GA runs DefaultGA, configurable at run time; other operator combinations are passed in as an
+// engine.
 class GA {
 public:
     using Gene = BinaryCostFunction::Gene;
     using Chromosome = BinaryCostFunction::Chromosome;
-    using Population = std::unordered_map<std::size_t, Chromosome>;
+    using PackedChromosome = ::PackedChromosome;
+    using Population = PopulationArena;
+    using Engine = Xoshiro256;
+    using StopCriteria = GAInterface::StopCriteria;
+    using StopReason = GAInterface::StopReason;
+    using Mode = GAInterface::Mode;
 
     // Default constructor that uses random seed for the random number generator
-    GA() = default;
+    GA();
 
     // Constructor that takes in a seed to allow for deterministic results
     explicit GA(std::size_t seed);
 
-    // Sets the cost function that the GA will use. The number of genes in each chromosome is automatically synced
-    // to the incoming cost function. Will throw if the cost function has not been configured.
-    void set_cf(const BinaryCostFunction* cf);
+    // Runs the given engine, e.g. std::make_unique<BasicGA<Knapsack, TournamentSelection, UniformCrossover>>(seed)
+    explicit GA(std::unique_ptr<GAInterface> engine) noexcept : engine_(std::move(engine)) {}
 
-    // Adjusts the parameters that the GA used to find the solution and randomly initializes the population
-    void set_parameters(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate);
+    // Reseeds the random number generator. Takes effect at the next set_parameters, which draws the initial
+    // population and the offspring streams from it.
+    void set_seed(std::size_t seed) noexcept { engine_->set_seed(seed); }
 
-    // Turnover the population of chromosomes by using the select, cross & mutate functions.
+    // Sets the cost function that the GA will use. The number of genes in each chromosome is automatically synced
+    // to the incoming cost function. Will throw if the cost function has not been configured, or is not of the
+    // engine's cost function type.
+    void set_cf(const BinaryCostFunction* cf) { engine_->set_cf(cf); }
+
+    // Sets the number of threads used for evaluation, repair and offspring production. 1 (the default) runs
+    // everything on the calling thread and 0 uses one thread per hardware thread. The cost function's eval must be
+    // safe to call concurrently when more than one thread is used.
+    void set_num_threads(std::size_t num_threads) { engine_->set_num_threads(num_threads); }
+
+    // Sets the operator used to repair unfeasible chromosomes. nullptr (the default) selects TrimRepair.
+    // Set it before set_parameters so it also applies to the initial population. Will throw if the engine's repair
+    // is fixed at compile time.
+    void set_repair(const RepairOperator* repair) { engine_->set_repair(repair); }
+
+    // Sets the parent selection policy. nullptr (the default) selects tournament selection with the tournament size
+    // given to set_parameters. The policy is not owned and may be shared between GAs. Steady state steps always use
+    // tournament selection since they do not keep a full ranking. Will throw if the engine's selection is fixed at
+    // compile time.
+    void set_selection(const SelectionPolicy* selection) { engine_->set_selection(selection); }
+
+    // Sets a cache of chromosome costs consulted before the cost function's eval, which pays off for expensive
+    // cost functions once the population holds many duplicates. The cache is not owned and nullptr (the default)
+    // disables it. Cost functions with running totals never use it since their costs are already O(1) to compute.
+    // Set it before set_parameters; it is cleared whenever the cost function changes.
+    void set_fitness_cache(FitnessCache* cache) noexcept { engine_->set_fitness_cache(cache); }
+
+    // Sets the observer that is told every recorded best cost (see ProgressObserver.h). It is not owned and nullptr
+    // (the default) turns it off.
+    void set_progress_observer(ProgressObserver* observer) noexcept { engine_->set_progress_observer(observer); }
+
+    // Selects generational (the default) or steady state evolution. In steady state mode every "generation" of
+    // new_population is one step that breeds num_replacements children, mutates them at the mutation rate and lets
+    // each replace the current worst chromosome unless it is worse. The best chromosome is therefore never lost and
+    // num_elite has no effect. Will throw if num_replacements is 0.
+    void set_mode(Mode mode, std::size_t num_replacements = 1) { engine_->set_mode(mode, num_replacements); }
+
+    // Sets the criteria checked before every generation (steady state step) of new_population. The diversity
+    // criterion costs O(population size * words per chromosome) per check, so in steady state mode it is only
+    // checked once per population turnover.
+    void set_stop_criteria(const StopCriteria& criteria) noexcept { engine_->set_stop_criteria(criteria); }
+
+    // Returns why the last call to new_population stopped
+    [[nodiscard]] StopReason get_stop_reason() const noexcept { return engine_->get_stop_reason(); }
+
+    // Fraction of genes that are not yet the same in every chromosome - 0 means the population has converged
+    [[nodiscard]] double get_diversity() const noexcept { return engine_->get_diversity(); }
+
+    // Seeds every new population with num_chromosomes packed chromosomes (e.g. a WarmStart's genes) in its first
+    // slots; the rest are random and unfeasible seeds are repaired. The chromosomes are copied. Takes effect at the
+    // next set_parameters and is cleared by set_cf. Will throw if the CF has not been set.
+    void set_warm_start(const packed::Word* genes, std::size_t num_chromosomes) {
+        engine_->set_warm_start(genes, num_chromosomes);
+    }
+
+    // Adjusts the parameters that the GA used to find the solution and randomly initializes the population.
     // Will throw if any of the GA parameters are invalid or if the CF has not been set.
-    void new_population(std::size_t num_generations) noexcept;
+    void set_parameters(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate) {
+        engine_->set_parameters(pop_size, num_elite, t_size, mutation_rate);
+    }
+
+    // Turnover the population of chromosomes by using the select, cross & mutate functions.
+    // Does not throw - the CF and the GA parameters are validated by set_parameters (or load_checkpoint), one of which
+    // must have been called first.
+    // Returns early if one of the stop criteria is met, after recording the final best cost.
+    void new_population(std::size_t num_generations) noexcept { engine_->new_population(num_generations); }
+
+    // Writes the full GA state (parameters, population, costs, ranks, rng states and best costs so far) to a binary
+    // checkpoint (see Checkpoint.h). The file is replaced atomically. Will throw if there is no population or the
+    // file cannot be written.
+    void save_checkpoint(const std::string& filename) const { engine_->save_checkpoint(filename); }
+
+    // Restores a checkpoint written by a GA of the same type, so further generations continue exactly as they would
+    // have in the saved GA. The CF must be set to the one the checkpoint was made with; the cache, repair operator
+    // and stop criteria are not part of the checkpoint. Will throw if the file cannot be read, is corrupt or does not
+    // match the CF.
+    void load_checkpoint(const std::string& filename) { engine_->load_checkpoint(filename); }
 
     // Returns the cost of the best chromosome
-    [[nodiscard]] std::size_t get_best_cost() const noexcept { return best_costs_.back(); }
+    [[nodiscard]] std::size_t get_best_cost() const noexcept { return engine_->get_best_cost(); }
 
     // Returns the best chromosome (vector of genes)
-    [[nodiscard]] Chromosome get_best_chromosome() const noexcept { return population_.at(ranks_[0]); }
+    [[nodiscard]] Chromosome get_best_chromosome() const noexcept { return engine_->get_best_chromosome(); }
 
-    // Returns the generation in which the best solution was found
-    [[nodiscard]] std::size_t get_solution_generation() const noexcept;
+    // Returns a view of the best chromosome in its bit-packed form. Invalidated by the next call to new_population.
+    [[nodiscard]] PackedView get_best_packed() const noexcept { return engine_->get_best_packed(); }
 
-    void prep_outfile(const std::string& filename, std::size_t num_gens, std::size_t num_runs) const;
+    // Migration support for multi-population models (see IslandGA). Chromosomes are exchanged as packed words,
+    // chromosome i of a batch starting at genes + i * words_per_chromosome().
+    [[nodiscard]] std::size_t words_per_chromosome() const noexcept { return engine_->words_per_chromosome(); }
 
-    // Exports the GA parameters and results to file. This can be improved to extract more info from the
-    // GA if desired.
-    void export_results(const std::string& filename) const;
+    // Copies the num_chromosomes best ranked chromosomes to genes, best first, and their costs to costs if given
+    void export_elites(std::size_t num_chromosomes, packed::Word* genes, std::size_t* costs = nullptr) const noexcept {
+        engine_->export_elites(num_chromosomes, genes, costs);
+    }
 
-    // For testing & possibly output (best chromosome)
-    std::ostream& print(std::ostream& os) const;
-    friend std::ostream &operator<<(std::ostream& os, const GA& ga) { return ga.print(os); }
+    // Overwrites the num_chromosomes worst ranked chromosomes with the given (feasible) chromosomes and re-ranks the
+    // population. The migrants are evaluated unless their costs are given; cost functions with running totals
+    // always recompute the totals. Does not allocate.
+    void import_migrants(const packed::Word* genes, std::size_t num_chromosomes, const std::size_t* costs = nullptr) noexcept {
+        engine_->import_migrants(genes, num_chromosomes, costs);
+    }
 
-    GA &operator=(const GA &) = delete;
-    GA(const GA &) = delete;
-private:
-    std::size_t chromosome_size_ = 0;
-    const BinaryCostFunction* cf_ = nullptr;
+    // Returns the best cost of each generation
+    [[nodiscard]] const std::vector<std::size_t>& get_best_costs() const noexcept { return engine_->get_best_costs(); }
 
-    // GA parameters
-    std::size_t population_size_ = 0;
-    std::size_t num_elite_ = 0;
-    std::size_t tournament_size_ = 0;
-    std::size_t num_mutations_ = 0;
-
-    Population                  population_;    // The population of chromosomes
-    std::vector<std::size_t>    ranks_;         // Stores the rank of each chromosome - rank[0] is best
-    std::vector<std::size_t>    costs_;         // Stores the costs/fitness' of each chromosome
-    std::vector<std::size_t>    best_costs_;    // Stores the highest fitness chromosome of each generation
-
-    // Initializes all the genes at random - uniform distribution of In's (1) and Out's (0)
-    // and calculates their initial costs
-    void rand_init_() noexcept;
-
-    // Calculate the cost or fitness of each chromosome in the population.
-    // num_elite is used to specify elite chromosomes.
-    void calculate_costs_(std::size_t num_elite = 0) noexcept;
-
-    // Sets the cost of chromosome 'chromosome_no' to cost
-    // No error checking since this is only used internally
-    void set_cost_(std::size_t chromosome_no, std::size_t cost) { costs_[chromosome_no] = cost; }
+    // Returns the generation in which the best solution was found
+    [[nodiscard]] std::size_t get_solution_generation() const noexcept { return engine_->get_solution_generation(); }
 
-    // Return the costs/fitness' of a chromosome.
-    [[nodiscard]] std::size_t cost_(std::size_t chromosome_no) const noexcept { return costs_[chromosome_no]; }
+#ifdef GA_TELEMETRY
+    // Telemetry builds only (see Telemetry.h). Sets the observer that receives the generation records; it is not
+    // owned and nullptr (the default) just keeps the most recent records in the ring buffer.
+    void set_telemetry_observer(TelemetryObserver* observer) noexcept { engine_->set_telemetry_observer(observer); }
 
-    // Returns the chromosome number of the chromosome with the given rank
-    [[nodiscard]] std::size_t chromosome_at_rank_(std::size_t rank) const noexcept { return ranks_[rank]; }
+    // Measures the diversity every interval generations (steady state steps) - 0 never. A measurement costs
+    // O(population size * words per chromosome). Defaults to every generation.
+    void set_diversity_interval(std::size_t interval) noexcept { engine_->set_diversity_interval(interval); }
 
-    // Stores the cost of the most fit chromosome - for output purposes
-    void store_best_cost_() noexcept { best_costs_.push_back(cost_(ranks_[0])); }
+    // The buffered telemetry records
+    [[nodiscard]] const TelemetryRing& get_telemetry() const noexcept { return engine_->get_telemetry(); }
+#endif
 
-    // Tournament selection with replacement. A higher tournament size increases the selection pressure.
-    // Tournament size of 1 is uniform selection.
-    [[nodiscard]] std::size_t select_() noexcept;
+#ifdef GA_COUNT_ALLOCATIONS
+    // Debug builds only: the number of heap allocations made inside the generation loop of the last call to
+    // new_population. Should always be zero.
+    [[nodiscard]] std::size_t loop_allocations() const noexcept { return engine_->loop_allocations(); }
+#endif
 
-    // Crosses the 2 parent chromosomes and with the given chromosome numbers and returns a child chromosome
-    // that is a combination of the 2 parent chromosomes.
-    [[nodiscard]] Chromosome cross_(std::size_t p1_chromosome_no, std::size_t p2_chromosome_no) noexcept;
+    void prep_outfile(const std::string& filename, std::size_t num_gens, std::size_t num_runs) const {
+        engine_->prep_outfile(filename, num_gens, num_runs);
+    }
 
-    // Performs num_mutations mutations at random throughout the population. A mutation simply toggles the targeted
-    // gene (In to Out, Out to In). Elite chromosomes (if specified) are immune to mutations.
-    void mutate_() noexcept;
+    // Exports the GA parameters and results to file. This can be improved to extract more info from the
+    // GA if desired.
+    void export_results(const std::string& filename) const { engine_->export_results(filename); }
 
-    // Ensures all chromosomes correspond to feasible solutions.
-    // Assumes unfeasible chromosome have a cost of zero!
-    void repair_() noexcept;
+    // For testing & possibly output (best chromosome)
+    std::ostream& print(std::ostream& os) const { return engine_->print(os); }
+    friend std::ostream &operator<<(std::ostream& os, const GA& ga) { return ga.print(os); }
 
-    // rng engine
-    std::mt19937 eng_{std::random_device{}()};
+    // The engine behind the facade
+    [[nodiscard]] GAInterface& engine() noexcept { return *engine_; }
+    [[nodiscard]] const GAInterface& engine() const noexcept { return *engine_; }
 
-    // Returns a random unsigned integer in the range [0, max] -> should use population_size_-1 & chromosome_size_-1
-    // where applicable as max argument
-    std::size_t rng_(std::size_t max) { return std::uniform_int_distribution<std::size_t>{0, max}(eng_); }
+    GA &operator=(const GA &) = delete;
+    GA(const GA &) = delete;
+private:
+    std::unique_ptr<GAInterface> engine_;
 };
 
 #endif //PROJECT_GA_H
\ No newline at end of file
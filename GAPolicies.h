@@ -0,0 +1,169 @@
+#ifndef PROJECT_GAPOLICIES_H
+#define PROJECT_GAPOLICIES_H
+
+#include <cmath>    // std::log, std::log1p - geometric mutation gaps
+
+#include "PackedChromosome.h"
+#include "Random.h"
+#include "Repair.h"
+#include "Selection.h"
+
+// Compile-time operator policies for BasicGA (see BasicGA.h). A policy is a plain class with the member functions
+// listed below; BasicGA calls them by their qualified names, so the calls are not virtual and are inlined into the
+// generation loop. The SelectionPolicy and RepairOperator classes are also valid policies, and the Dynamic*
+// policies keep the run-time interfaces available behind a single branch.
+//
+//  Selection:  bool needs_cumulative() const noexcept
+//              void select(const SelectionView&, Xoshiro256&, std::size_t* parents, std::size_t num_parents) const noexcept
+//  Crossover:  static constexpr bool avoid_clones
+//              CrossoverResult cross(PackedView p1, std::size_t p1_cost, PackedView p2, std::size_t p2_cost,
+//                                    PackedRef child, Xoshiro256&) const noexcept
+//  Mutation:   void set_probability(double probability) noexcept
+//              void mutate(Xoshiro256&, std::size_t num_positions, Flip&& flip) const noexcept - calls flip(position)
+//  Repair:     std::size_t repair(const BinaryCostFunction&, PackedRef, Totals&) const noexcept
+
+// Selection through a SelectionPolicy chosen at run time. nullptr (the default) selects tournament selection with
+// the tournament size given to the GA's set_parameters.
+class DynamicSelection {
+public:
+    explicit DynamicSelection(const SelectionPolicy* policy = nullptr) noexcept : policy_(policy) {}
+
+    void set_policy(const SelectionPolicy* policy) noexcept { policy_ = policy; }
+    void set_tournament_size(std::size_t t_size) noexcept { tournament_ = TournamentSelection(t_size); }
+
+    [[nodiscard]] bool needs_cumulative() const noexcept { return policy_ && policy_->needs_cumulative(); }
+
+    void select(const SelectionView& view, Xoshiro256& eng, std::size_t* parents, std::size_t num_parents) const noexcept {
+        if (policy_) {
+            policy_->select(view, eng, parents, num_parents);
+        } else {
+            tournament_.TournamentSelection::select(view, eng, parents, num_parents);
+        }
+    }
+private:
+    const SelectionPolicy* policy_;     // Not owned - nullptr uses tournament_
+    TournamentSelection tournament_;
+};
+
+// How a crossover built the child, so the GA can update the child's running totals. A spliced child is the head
+// parent's genes [0, mid) followed by the other parent's genes [mid, n), and its totals are derived from the parents'
+// by scanning the shorter half; any other child has its totals computed from scratch.
+struct CrossoverResult {
+    bool spliced = false;
+    bool second_is_head = false;    // The head is the second parent rather than the first
+    std::size_t mid = 0;
+};
+
+// The child gets half of its genes from parent 1 and the other half from parent two. If the number of genes is odd,
+// the extra gene comes from the most fit parent. Whole words are copied and only the word containing the midpoint
+// is masked.
+class SinglePointCrossover {
+public:
+    static constexpr bool avoid_clones = true;
+
+    CrossoverResult cross(PackedView p1, std::size_t p1_cost, PackedView p2, std::size_t p2_cost, PackedRef child,
+                          Xoshiro256&) const noexcept {
+        // The most fit parent provides the head
+        const bool second_is_head = p2_cost > p1_cost;
+        const auto& head = second_is_head ? p2 : p1;
+        const auto& tail = second_is_head ? p1 : p2;
+        // Handle odd chromosome lengths
+        const std::size_t mid = (child.num_genes() + 2 - 1) / 2;
+        packed::splice(child.data(), head.words(), tail.words(), child.num_genes(), mid);
+        return {true, second_is_head, mid};
+    }
+};
+
+// If the 2 parent chromosomes have the same gene at a given position, the child will have the same gene. If the
+// parent genes at a given position are different, the child will get a random gene value (0 or 1). Done a word at
+// a time: the bits where the parents agree are kept and the rest come from a random word.
+class UniformCrossover {
+public:
+    static constexpr bool avoid_clones = true;
+
+    CrossoverResult cross(PackedView p1, std::size_t, PackedView p2, std::size_t, PackedRef child,
+                          Xoshiro256& eng) const noexcept {
+        for (std::size_t w = 0; w < child.num_words(); ++w) {
+            const auto differ = p1.words()[w] ^ p2.words()[w];
+            child.data()[w] = (p1.words()[w] & ~differ) | (eng() & differ);
+        }
+        return {};
+    }
+};
+
+// A crossover that keeps whichever parents the selection drew, which allows for direct clones (a chromosome
+// crossed with itself) and is potentially undesirable, but saves the clone check and redraws
+template <typename Crossover>
+class AllowClones : public Crossover {
+public:
+    static constexpr bool avoid_clones = false;
+
+    using Crossover::Crossover;
+};
+
+// Flips every mutable gene independently with the given probability. The walk jumps from one flip to the next by
+// geometric gaps: one random number per flip, no rejections and nothing to do for genes that are not mutated.
+class GeometricMutation {
+public:
+    void set_probability(double probability) noexcept {
+        probability_ = probability;
+        log_keep_ = std::log1p(-probability);
+    }
+
+    template <typename Flip>
+    void mutate(Xoshiro256& eng, std::size_t num_positions, Flip&& flip) const noexcept {
+        for (std::size_t position = gap_(eng, num_positions); position < num_positions;
+             position += 1 + gap_(eng, num_positions)) {
+            flip(position);
+        }
+    }
+private:
+    double probability_ = 0.;
+    double log_keep_ = 0.;      // log(1 - probability_) - scales the geometric gaps
+
+    // Number of genes to skip before the next mutated gene, capped at limit. Inverse transform sampling of the
+    // geometric distribution: floor(log(u) / log(1 - p)) for u uniform in (0, 1]
+    [[nodiscard]] std::size_t gap_(Xoshiro256& eng, std::size_t limit) const noexcept {
+        if (probability_ <= 0.) {
+            return limit;
+        }
+        if (probability_ >= 1.) {
+            return 0;
+        }
+        const double gap = std::log(1. - rng::canonical(eng)) / log_keep_;
+        return gap < static_cast<double>(limit) ? static_cast<std::size_t>(gap) : limit;
+    }
+};
+
+// Flips exactly probability * num_positions (rounded) uniformly drawn genes. Positions are drawn with replacement,
+// so a gene drawn twice is flipped back. One bounded random number per flip whatever the probability.
+class UniformCountMutation {
+public:
+    void set_probability(double probability) noexcept { probability_ = probability; }
+
+    template <typename Flip>
+    void mutate(Xoshiro256& eng, std::size_t num_positions, Flip&& flip) const noexcept {
+        const auto num_flips = static_cast<std::size_t>(probability_ * static_cast<double>(num_positions) + .5);
+        for (std::size_t mutation = 0; mutation < num_flips; ++mutation) {
+            flip(static_cast<std::size_t>(rng::bounded(eng, num_positions)));
+        }
+    }
+private:
+    double probability_ = 0.;
+};
+
+// Repair through a RepairOperator chosen at run time. nullptr (the default) selects TrimRepair.
+class DynamicRepair {
+public:
+    explicit DynamicRepair(const RepairOperator* repair = nullptr) noexcept : repair_(repair) {}
+
+    void set_operator(const RepairOperator* repair) noexcept { repair_ = repair; }
+
+    std::size_t repair(const BinaryCostFunction& cf, PackedRef chromosome, BinaryCostFunction::Totals& totals) const noexcept {
+        return repair_ ? repair_->repair(cf, chromosome, totals) : trim_.TrimRepair::repair(cf, chromosome, totals);
+    }
+private:
+    const RepairOperator* repair_;      // Not owned - nullptr uses trim_
+    TrimRepair trim_;
+};
+#endif //PROJECT_GAPOLICIES_H
@@ -0,0 +1,124 @@
+#include <algorithm>    // std::min
+#include <random>       // Island seeds
+#include <stdexcept>    // std::invalid_argument
+#include <thread>       // std::thread::hardware_concurrency
+
+#include "IslandGA.h"
+
+using std::invalid_argument; // If the migration or GA parameters are invalid
+
+IslandGA::IslandGA(std::size_t num_islands) :
+    IslandGA(num_islands, std::random_device{}())
+{}
+
+// Island seeds are drawn from an engine seeded with the given seed so every island gets a different stream
+IslandGA::IslandGA(std::size_t num_islands, std::size_t seed) {
+    if (num_islands == 0) {
+        throw invalid_argument("An island GA needs at least one island.");
+    }
+    std::mt19937_64 seeds(seed);
+    for (std::size_t island_no = 0; island_no < num_islands; ++island_no) {
+        islands_.push_back(std::make_unique<GA>(static_cast<std::size_t>(seeds())));
+    }
+}
+
+void IslandGA::set_cf(const BinaryCostFunction* cf) {
+    for (auto& island : islands_) {
+        island->set_cf(cf);
+    }
+    cf_ = cf;
+    population_size_ = 0;
+}
+
+void IslandGA::set_repair(const RepairOperator* repair) {
+    for (auto& island : islands_) {
+        island->set_repair(repair);
+    }
+}
+
+void IslandGA::set_num_threads(std::size_t num_threads) {
+    num_threads_ = num_threads;
+    pool_ = nullptr;
+}
+
+void IslandGA::set_migration(std::size_t interval, std::size_t num_migrants) {
+    if (interval == 0 || (population_size_ != 0 && num_migrants > population_size_)) {
+        throw invalid_argument("The migration parameters are invalid.");
+    }
+    interval_ = interval;
+    num_migrants_ = num_migrants;
+    if (population_size_ != 0) {
+        make_rings_();
+    }
+}
+
+void IslandGA::set_parameters(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate) {
+    if (num_migrants_ > pop_size) {
+        throw invalid_argument("More migrants than chromosomes in an island.");
+    }
+    for (auto& island : islands_) {
+        island->set_parameters(pop_size, num_elite, t_size, mutation_rate);
+    }
+    population_size_ = pop_size;
+    make_rings_();
+    update_best_();
+}
+
+void IslandGA::new_population(std::size_t num_generations) {
+    if (population_size_ == 0) {
+        throw invalid_argument("The GA parameters have not been set.");
+    }
+    if (!pool_) {
+        const std::size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+        pool_ = std::make_unique<ThreadPool>(num_threads_ ? num_threads_ : std::min(islands_.size(), hardware_threads));
+    }
+    pool_->parallel_for(islands_.size(), [&](std::size_t island_no) { evolve_island_(island_no, num_generations); });
+    update_best_();
+}
+
+void IslandGA::make_rings_() {
+    const std::size_t batch_words = num_migrants_ * islands_.front()->words_per_chromosome();
+    rings_.clear();
+    buffers_.clear();
+    for (std::size_t island_no = 0; island_no < islands_.size(); ++island_no) {
+        rings_.push_back(std::make_unique<MigrationRing>(ring_capacity_, batch_words));
+        buffers_.emplace_back(batch_words);
+    }
+}
+
+// Islands run independently between migrations. Sending comes before receiving so that a batch sent by the previous
+// island at the same epoch is picked up now rather than one interval later whenever it is already there.
+void IslandGA::evolve_island_(std::size_t island_no, std::size_t num_generations) noexcept {
+    auto& ga = *islands_[island_no];
+    auto& outbox = *rings_[island_no];
+    auto& inbox = *rings_[(island_no + islands_.size() - 1) % islands_.size()];
+    auto* batch = buffers_[island_no].data();
+    const bool migrate = islands_.size() > 1 && num_migrants_ > 0;
+    for (std::size_t generation = 0; generation < num_generations;) {
+        const std::size_t epoch = std::min(interval_, num_generations - generation);
+        ga.new_population(epoch);
+        generation += epoch;
+        if (migrate) {
+            ga.export_elites(num_migrants_, batch);
+            outbox.try_push(batch);
+            while (inbox.try_pop(batch)) {
+                ga.import_migrants(batch, num_migrants_);
+            }
+        }
+    }
+}
+
+// The islands' current best chromosomes are evaluated directly since migration may have replaced chromosomes after
+// their last recorded generation. Ties go to the lowest island.
+void IslandGA::update_best_() {
+    auto& [best_cost, best_chromosome] = best_;
+    best_cost = 0;
+    best_chromosome.clear();
+    for (const auto& island : islands_) {
+        if (const std::size_t cost = cf_->eval(island->get_best_packed());
+            best_chromosome.empty() || cost > best_cost) {
+            best_cost = cost;
+            best_chromosome = BinaryCostFunction::unpack(island->get_best_packed());
+        }
+    }
+}
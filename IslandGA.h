@@ -0,0 +1,84 @@
+#ifndef PROJECT_ISLANDGA_H
+#define PROJECT_ISLANDGA_H
+
+#include <memory>
+#include <utility>  // std::pair
+#include <vector>
+
+#include "GA.h"
+#include "MigrationRing.h"
+#include "ThreadPool.h"
+
+// Island model GA: num_islands independent GA populations evolve on separate threads and only interact through
+// migration. Every interval generations each island sends copies of its num_migrants best chromosomes to the next
+// island of a ring topology (island i -> island i + 1) and replaces its worst chromosomes with the migrants it has
+// received. Migrants travel over lock-free SPSC rings (MigrationRing), so islands never wait for each other - a
+// migrant batch that finds the ring full is dropped and an island that has received nothing carries on.
+// Each island is seeded from the IslandGA seed, but since migration is asynchronous the results are only
+// reproducible with a single island or with migration disabled.
+class IslandGA {
+public:
+    using Chromosome = BinaryCostFunction::Chromosome;
+
+    // Creates num_islands GAs seeded at random
+    explicit IslandGA(std::size_t num_islands);
+
+    // Creates num_islands GAs whose seeds are derived from the given seed
+    IslandGA(std::size_t num_islands, std::size_t seed);
+
+    // Sets the cost function of every island. Will throw if the cost function has not been configured.
+    void set_cf(const BinaryCostFunction* cf);
+
+    // Sets the repair operator of every island - see GA::set_repair. Will throw if the islands' repair is fixed at
+    // compile time.
+    void set_repair(const RepairOperator* repair);
+
+    // Sets the number of threads the islands run on. 0 (the default) uses one thread per island, capped at the
+    // number of hardware threads. Islands share threads when there are fewer threads than islands.
+    void set_num_threads(std::size_t num_threads);
+
+    // Sets the number of generations between migrations and the number of chromosomes each island sends. 0 migrants
+    // disables migration. Will throw if num_migrants exceeds the population size.
+    void set_migration(std::size_t interval, std::size_t num_migrants);
+
+    // Sets the parameters of every island (see GA::set_parameters) and randomly initializes the populations
+    void set_parameters(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate);
+
+    // Evolves every island for num_generations generations
+    void new_population(std::size_t num_generations);
+
+    // Returns the cost of the best chromosome across all islands
+    [[nodiscard]] std::size_t get_best_cost() const noexcept { return best_.first; }
+
+    // Returns the best chromosome across all islands
+    [[nodiscard]] const Chromosome& get_best_chromosome() const noexcept { return best_.second; }
+
+    [[nodiscard]] std::size_t num_islands() const noexcept { return islands_.size(); }
+    [[nodiscard]] const GA& island(std::size_t island_no) const noexcept { return *islands_[island_no]; }
+private:
+    // Migrant batches each ring can hold before it starts dropping them
+    static constexpr std::size_t ring_capacity_ = 4;
+
+    const BinaryCostFunction* cf_ = nullptr;
+    std::vector<std::unique_ptr<GA>>            islands_;
+    std::vector<std::unique_ptr<MigrationRing>> rings_;     // rings_[i] carries island i's emigrants to island i + 1
+    std::vector<std::vector<packed::Word>>      buffers_;   // Per island staging buffer for one migrant batch
+    std::unique_ptr<ThreadPool> pool_;
+    std::size_t num_threads_ = 0;
+
+    std::size_t interval_ = 10;
+    std::size_t num_migrants_ = 1;
+    std::size_t population_size_ = 0;   // 0 until set_parameters has been called
+
+    std::pair<std::size_t, Chromosome> best_;
+
+    // Allocates the rings and staging buffers for the current migration size and chromosome length
+    void make_rings_();
+
+    // Thread body: evolves one island, migrating every interval_ generations
+    void evolve_island_(std::size_t island_no, std::size_t num_generations) noexcept;
+
+    // Finds the best chromosome across the islands
+    void update_best_();
+};
+#endif //PROJECT_ISLANDGA_H
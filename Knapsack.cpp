@@ -1,6 +1,11 @@
+#include <algorithm> // std::stable_sort, std::nth_element
+#include <functional> // std::greater
+#include <numeric>   // std::iota, std::accumulate
 #include <ostream>
+#include <utility>   // std::move
 
 #include "Knapsack.h"
+#include "EvalKernel.h"
 
 // Constructor that requires the total weight/value pair configurations, the capacity of the backpack and
 // the maximum number of items it can hold.
@@ -13,6 +18,15 @@ Knapsack::Knapsack(std::size_t num_configurations, std::size_t max_weight, std::
         dist_(1, std::max(static_cast<std::size_t>(1), static_cast<std::size_t>(max_weight*3 / num_items)))
 {}
 
+Knapsack::Knapsack(std::shared_ptr<const void> storage, const std::size_t* weights, const std::size_t* prices,
+                   std::size_t num_configurations, std::size_t max_weight, std::size_t num_items) :
+        Knapsack(num_configurations, max_weight, num_items)
+{
+    storage_ = std::move(storage);
+    external_weights_ = weights;
+    external_prices_ = prices;
+}
+
 // Fills the cost function with random configurations based on its weight capacity and the number of items it can store.
 void Knapsack::random_configs() noexcept {
     std::size_t item_no = 0;
@@ -23,11 +37,14 @@ void Knapsack::random_configs() noexcept {
 
 // Adds a configuration variable to the cost function
 void Knapsack::add_config(std::size_t weight, std::size_t price) noexcept {
-    configurations_.emplace_back(std::make_pair(weight, price));
+    weights_.push_back(weight);
+    prices_.push_back(price);
 }
 
 // Evaluates the input chromosome and returns its fitness/cost.
 std::size_t Knapsack::eval(const Chromosome& chromosome) const noexcept {
+    const auto* weights = this->weights();
+    const auto* prices = this->prices();
     std::size_t current_weight, cost, num_items, index;
     current_weight = cost = num_items = index = 0;
 
@@ -35,9 +52,8 @@ std::size_t Knapsack::eval(const Chromosome& chromosome) const noexcept {
     // (iterate over chromosome and configuration simultaneously)
     for (const auto& gene : chromosome) {
         if (gene == Gene::In) {
-            const auto& [weight, price] = configurations_[index];
-            current_weight += weight;
-            cost += price;
+            current_weight += weights[index];
+            cost += prices[index];
             ++num_items;
         }
         ++index;
@@ -50,37 +66,150 @@ std::size_t Knapsack::eval(const Chromosome& chromosome) const noexcept {
     return cost;
 }
 
+// Evaluates a bit-packed chromosome.
+std::size_t Knapsack::eval(PackedView chromosome) const noexcept {
+    return eval_totals(totals(chromosome, 0, chromosome.num_genes()));
+}
+
+// Batch evaluation - a plain loop over the non-virtual totals computation, so it never allocates.
+void Knapsack::eval_batch(const packed::Word* genes, std::size_t words_per_chromosome, std::size_t num_chromosomes,
+                          std::size_t* costs) const noexcept {
+    for (std::size_t chromosome_no = 0; chromosome_no < num_chromosomes; ++chromosome_no) {
+        const PackedView chromosome(genes + chromosome_no * words_per_chromosome, num_vars());
+        costs[chromosome_no] = eval_totals(Knapsack::totals(chromosome, 0, chromosome.num_genes()));
+    }
+}
+
+// Sums the weights and prices of the In genes in [first_gene, last_gene). The partial words at either end of the
+// range are masked and walked bit by bit; the full words in between go through the vectorized kernel.
+Knapsack::Totals Knapsack::totals(PackedView chromosome, std::size_t first_gene, std::size_t last_gene) const noexcept {
+    Totals totals;
+    if (first_gene >= last_gene) {
+        return totals;
+    }
+    const auto* words = chromosome.words();
+    const auto* weights = this->weights();
+    const auto* prices = this->prices();
+    const auto add_word = [&](std::size_t w, packed::Word word) {
+        for (; word; word &= word - 1) {
+            const std::size_t gene = w * packed::bits_per_word + packed::lowest_bit(word);
+            totals.weight += weights[gene];
+            totals.value += prices[gene];
+            ++totals.count;
+        }
+    };
+    const std::size_t first_word = packed::word_index(first_gene);
+    const std::size_t last_word = packed::word_index(last_gene - 1);
+    const auto first_mask = ~packed::range_mask(0, first_gene % packed::bits_per_word);
+    const auto last_mask = packed::range_mask(0, (last_gene - 1) % packed::bits_per_word + 1);
+    if (first_word == last_word) {
+        add_word(first_word, words[first_word] & first_mask & last_mask);
+        return totals;
+    }
+    add_word(first_word, words[first_word] & first_mask);
+    const std::size_t offset = (first_word + 1) * packed::bits_per_word;
+    totals += eval_kernel::sum_words(words + first_word + 1, last_word - first_word - 1,
+                                     weights + offset, prices + offset);
+    add_word(last_word, words[last_word] & last_mask);
+    return totals;
+}
+
+// Sorts an index permutation rather than the configurations themselves
+std::vector<std::size_t> Knapsack::ratio_order() const {
+    const auto* weights = this->weights();
+    const auto* prices = this->prices();
+    std::vector<std::size_t> order(num_configs());
+    std::iota(std::begin(order), std::end(order), 0);
+    std::stable_sort(std::begin(order), std::end(order), [weights, prices](std::size_t i, std::size_t j) {
+        return better_ratio(prices[i], weights[i], prices[j], weights[j]);
+    });
+    return order;
+}
+
+// Cross-multiplying alone would make a (0, 0) item tie with every item, which is not a strict weak ordering, so the
+// items are first split into three classes by their weight and price. Within the middle class a/b > c/d is tested
+// as a*d > c*b in double width arithmetic so neither truncation nor overflow can change the order.
+bool Knapsack::better_ratio(std::size_t price_i, std::size_t weight_i, std::size_t price_j, std::size_t weight_j) noexcept {
+#ifdef __SIZEOF_INT128__
+    using Wide = unsigned __int128;
+#else
+    using Wide = long double;
+#endif
+    const auto rank = [](std::size_t price, std::size_t weight) { return weight != 0 ? 1 : price != 0 ? 0 : 2; };
+    const int rank_i = rank(price_i, weight_i);
+    const int rank_j = rank(price_j, weight_j);
+    if (rank_i != rank_j) {
+        return rank_i < rank_j;
+    }
+    return rank_i == 1 && static_cast<Wide>(price_i) * weight_j > static_cast<Wide>(price_j) * weight_i;
+}
+
 // Greedy approach implementation
 std::pair<std::size_t, Knapsack::Chromosome> Knapsack::greedy_solve() const {
-    auto backpack = std::vector<Gene>(configurations_.size()); // Initialize empty backpack (chromosome in GA parlance)
-    auto configs_copy = configurations_;
-    std::sort(std::begin(configs_copy), std::end(configs_copy),
-              [](std::pair<std::size_t, std::size_t> i, std::pair<std::size_t, std::size_t> j) {
-                return (i.second / i.first) > (j.second / j.first);
-              });
+    return greedy_solve(ratio_order());
+}
+
+// Walks the ratio ordered index permutation so each chosen item maps straight back to its own gene - duplicate
+// configurations are told apart and no search is needed.
+std::pair<std::size_t, Knapsack::Chromosome> Knapsack::greedy_solve(const std::vector<std::size_t>& order) const {
+    const auto* weights = this->weights();
+    const auto* prices = this->prices();
+    auto backpack = std::vector<Gene>(num_configs()); // Initialize empty backpack (chromosome in GA parlance)
     // Add items to backpack according to the greedy approach algorithm
     std::size_t current_weight, num_items, cost;
     current_weight = num_items = cost = 0;
-    for (const auto& config: configs_copy) {
-        const auto& [weight, price] = config;
+    for (const auto index : order) {
+        if (num_items == num_items_) {
+            break;
+        }
         // Test if item will fit
-        if (current_weight + weight <= max_weight_ && num_items + 1 <= num_items_) {
-            backpack[std::distance(std::cbegin(configurations_),
-                                   std::find(std::cbegin(configurations_), std::cend(configurations_),
-                                             config))] = Gene::In;
-            cost += price;
-            current_weight += weight;
+        if (current_weight + weights[index] <= max_weight_) {
+            backpack[index] = Gene::In;
+            cost += prices[index];
+            current_weight += weights[index];
             ++num_items;
         }
     }
     return std::make_pair(cost, backpack);
 }
 
+std::size_t Knapsack::lp_bound() const {
+    return lp_bound(ratio_order());
+}
+
+std::size_t Knapsack::lp_bound(const std::vector<std::size_t>& order) const {
+#ifdef __SIZEOF_INT128__
+    using Wide = unsigned __int128;
+#else
+    using Wide = long double;
+#endif
+    const auto* weights = this->weights();
+    const auto* prices = this->prices();
+    // Fractional knapsack bound on the weight constraint alone
+    std::size_t bound = 0;
+    std::size_t remaining = max_weight_;
+    for (const auto index : order) {
+        if (weights[index] <= remaining) {
+            remaining -= weights[index];
+            bound += prices[index];
+        } else {
+            bound += static_cast<std::size_t>(static_cast<Wide>(prices[index]) * remaining / weights[index]);
+            break;
+        }
+    }
+    // The item limit on its own allows at most the num_items_ highest prices
+    if (num_items_ < num_configs()) {
+        std::vector<std::size_t> best_prices(prices, prices + num_configs());
+        std::nth_element(std::begin(best_prices), std::begin(best_prices) + num_items_, std::end(best_prices), std::greater<>());
+        bound = std::min(bound, std::accumulate(std::begin(best_prices), std::begin(best_prices) + num_items_, std::size_t{0}));
+    }
+    return bound;
+}
+
 // Displays the configurations in the cost function
 std::ostream& Knapsack::print(std::ostream& os) const {
-    for (const auto& config : configurations_) {
-        const auto& [weight, price] = config;
-        os << "(Weight, Price): (" << weight << ", " << price << ")\n";
+    for (std::size_t index = 0; index < num_configs(); ++index) {
+        os << "(Weight, Price): (" << weights()[index] << ", " << prices()[index] << ")\n";
     }
     return os;
 }
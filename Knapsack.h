@@ -3,18 +3,26 @@
 
 #include "BinaryCostFunction.h"
 
+#include <memory> // std::shared_ptr for externally owned configurations
 #include <random> // For random backpacks
 
 // Implements the cost function for a 0-1 knapsack type problem.
+// The configurations are stored as separate contiguous weight and price arrays so packed chromosomes can be evaluated
+// as a masked dot product against them (see EvalKernel.h). The arrays are either owned by the knapsack or borrowed
+// from external storage such as a memory-mapped instance file (see KnapsackLoader.h).
 class Knapsack : public BinaryCostFunction {
 public:
-    using Configurations = std::vector<std::pair<std::size_t, std::size_t>>;
-
     // Constructor that requires the total weight/value pair configurations, the capacity of the backpack and
     // the maximum number of items it can hold.
     // Also sets the rng tools used for the random backpacks
     Knapsack(std::size_t num_configurations, std::size_t max_weight, std::size_t num_items);
 
+    // Creates a knapsack over num_configurations weights and prices owned by someone else. Nothing is copied - the
+    // arrays must stay valid as long as the storage object (shared by all copies of the knapsack) is alive.
+    // Configurations must not be added to such a knapsack.
+    Knapsack(std::shared_ptr<const void> storage, const std::size_t* weights, const std::size_t* prices,
+             std::size_t num_configurations, std::size_t max_weight, std::size_t num_items);
+
     // Fills the cost function with random configurations based on its weight capacity and the number of items it can store.
     void random_configs() noexcept;
 
@@ -30,15 +38,67 @@ public:
     // Evaluates the input chromosome and returns its fitness/cost.
     [[nodiscard]] std::size_t eval(const Chromosome& chromosome) const noexcept override;
 
+    // Evaluates a bit-packed chromosome with the vectorized masked dot product kernel.
+    [[nodiscard]] std::size_t eval(PackedView chromosome) const noexcept override;
+
+    // Evaluates a contiguous batch of packed chromosomes in one pass without virtual dispatch per chromosome.
+    void eval_batch(const packed::Word* genes, std::size_t words_per_chromosome, std::size_t num_chromosomes,
+                    std::size_t* costs) const noexcept override;
+
+    // Delta evaluation through running weight/value/item count totals
+    [[nodiscard]] bool supports_totals() const noexcept override { return true; }
+    [[nodiscard]] Totals totals(PackedView chromosome, std::size_t first_gene, std::size_t last_gene) const noexcept override;
+    [[nodiscard]] Totals gene_totals(std::size_t gene) const noexcept override {
+        return {weights()[gene], prices()[gene], 1};
+    }
+    [[nodiscard]] std::size_t eval_totals(const Totals& totals) const noexcept override {
+        return Knapsack::feasible(totals) ? totals.value : 0;
+    }
+    [[nodiscard]] bool feasible(const Totals& totals) const noexcept override {
+        return totals.weight <= max_weight_ && totals.count <= num_items_;
+    }
+
+    // Contiguous weight and price arrays - gene i has weight weights()[i] and price prices()[i]
+    [[nodiscard]] const std::size_t* weights() const noexcept { return storage_ ? external_weights_ : weights_.data(); }
+    [[nodiscard]] const std::size_t* prices() const noexcept { return storage_ ? external_prices_ : prices_.data(); }
+    [[nodiscard]] std::size_t num_configs() const noexcept { return storage_ ? num_vars() : weights_.size(); }
+
+    // Returns the gene numbers sorted by descending price/weight ratio (ties keep gene order) - see better_ratio.
+    // O(n log n).
+    [[nodiscard]] std::vector<std::size_t> ratio_order() const;
+
+    // Strict weak ordering of items by descending price/weight ratio: weightless items with a price come first, then
+    // the others by their ratio, compared exactly by cross-multiplication, and items with neither weight nor price
+    // last. Returns true if item i (price_i, weight_i) goes before item j.
+    [[nodiscard]] static bool better_ratio(std::size_t price_i, std::size_t weight_i,
+                                           std::size_t price_j, std::size_t weight_j) noexcept;
+
     // Solves the backpack using a greedy approach. Returns the best cost and the solution chromosome as a pair object.
+    // Items are considered in descending price/weight order and added whenever they fit. O(n log n), or O(n) when
+    // given a precomputed ratio_order().
     [[nodiscard]] std::pair<std::size_t, Chromosome> greedy_solve() const;
+    [[nodiscard]] std::pair<std::size_t, Chromosome> greedy_solve(const std::vector<std::size_t>& order) const;
+
+    // Upper bound on the optimal cost from the LP relaxation: the fractional knapsack bound (items taken whole in
+    // ratio order, then a fraction of the first one that does not fit), tightened to the sum of the num_items best
+    // prices when the item limit is binding. Rounded down since the optimum is an integer.
+    [[nodiscard]] std::size_t lp_bound() const;
+    [[nodiscard]] std::size_t lp_bound(const std::vector<std::size_t>& order) const;
+
+    // Accessors for the constraints
+    [[nodiscard]] std::size_t max_weight() const noexcept { return max_weight_; }
+    [[nodiscard]] std::size_t max_items() const noexcept { return num_items_; }
 
     std::ostream& print(std::ostream& os) const;
     friend std::ostream &operator<<(std::ostream& os, const Knapsack& cf) { return cf.print(os); }
 private:
     const std::size_t   max_weight_; // The weight capacity of the backpack (assumed to be an unsigned integer based on the project handout)
     const std::size_t   num_items_;  // The maximum number of items that can be stored in the backpack
-    Configurations      configurations_; // The weight/value pairs corresponding to the genes in a chromosome
+    std::vector<std::size_t> weights_;   // The weights corresponding to the genes in a chromosome
+    std::vector<std::size_t> prices_;    // The values corresponding to the genes in a chromosome
+    std::shared_ptr<const void> storage_;           // Keeps external configurations alive - null when they are owned
+    const std::size_t* external_weights_ = nullptr; // External configurations, used instead of weights_/prices_
+    const std::size_t* external_prices_ = nullptr;
 
     std::mt19937 eng_{std::random_device{}()};      // rng engine for generating random backpacks
     std::uniform_int_distribution<std::size_t> dist_;   // range [1, max(max_weight*2/num_items,1)]
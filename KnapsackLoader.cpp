@@ -0,0 +1,148 @@
+#include <charconv>     // std::from_chars
+#include <cstring>      // std::memcpy, std::memcmp
+#include <fstream>
+#include <memory>       // std::shared_ptr
+#include <stdexcept>    // std::runtime_error, std::invalid_argument
+
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+
+#include "KnapsackLoader.h"
+
+using std::runtime_error;       // If an instance file cannot be opened, mapped or written
+using std::invalid_argument;    // If an instance file is malformed
+
+namespace {
+    // Read-only mapping of a whole file, unmapped on destruction
+    class FileMapping {
+    public:
+        explicit FileMapping(const std::string& filename) {
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+            struct stat status{};
+            if (fd < 0 || ::fstat(fd, &status) != 0) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+                throw runtime_error("Could not open the instance file " + filename + '.');
+            }
+            size_ = static_cast<std::size_t>(status.st_size);
+            void* mapping = (size_ != 0) ? ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+            ::close(fd);    // The mapping stays valid
+            if (mapping == MAP_FAILED) {
+                throw runtime_error("Could not map the instance file " + filename + '.');
+            }
+            data_ = static_cast<const char*>(mapping);
+        }
+        ~FileMapping() { ::munmap(const_cast<char*>(data_), size_); }
+
+        [[nodiscard]] const char* data() const noexcept { return data_; }
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+        // Hints at the expected access pattern of [0, size())
+        void advise(int advice) const noexcept { ::madvise(const_cast<char*>(data_), size_, advice); }
+
+        FileMapping &operator=(const FileMapping &) = delete;
+        FileMapping(const FileMapping &) = delete;
+    private:
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+    // Cursor over whitespace separated unsigned integers. Never allocates.
+    class NumberParser {
+    public:
+        NumberParser(const char* first, const char* last) noexcept : next_(first), last_(last) {}
+
+        // Parses the next number. Returns false at the end of the input or if the next token is not a number.
+        [[nodiscard]] bool next(std::size_t& value) noexcept {
+            while (next_ != last_ && (*next_ == ' ' || *next_ == '\t' || *next_ == '\n' || *next_ == '\r')) {
+                ++next_;
+            }
+            const auto [end, error] = std::from_chars(next_, last_, value);
+            if (error != std::errc()) {
+                return false;
+            }
+            next_ = end;
+            return true;
+        }
+    private:
+        const char* next_;
+        const char* last_;
+    };
+}
+
+// Anything after the n price/weight pairs (some instance sets append the optimum or a solution) is ignored.
+Knapsack knapsack_io::load_text(const std::string& filename) {
+    const FileMapping file(filename);
+    file.advise(MADV_SEQUENTIAL);
+    NumberParser parser(file.data(), file.data() + file.size());
+    std::size_t num_configs, max_weight;
+    if (!parser.next(num_configs) || !parser.next(max_weight)) {
+        throw invalid_argument(filename + " does not start with the number of items and the capacity.");
+    }
+    if (num_configs == 0) {
+        throw invalid_argument(filename + " does not hold any items.");
+    }
+    Knapsack knapsack(num_configs, max_weight, num_configs);
+    for (std::size_t item = 0; item < num_configs; ++item) {
+        std::size_t price, weight;
+        if (!parser.next(price) || !parser.next(weight)) {
+            throw invalid_argument(filename + " ends or is malformed at item " + std::to_string(item) + '.');
+        }
+        knapsack.add_config(weight, price);
+    }
+    return knapsack;
+}
+
+// The knapsack shares ownership of the mapping, so it (and every copy of it) keeps the file mapped.
+Knapsack knapsack_io::load_binary(const std::string& filename) {
+    auto file = std::make_shared<const FileMapping>(filename);
+    Header header{};
+    if (file->size() >= sizeof(header)) {
+        std::memcpy(&header, file->data(), sizeof(header));
+    }
+    if (file->size() < sizeof(header) || std::memcmp(header.magic, magic, sizeof(header.magic)) != 0 ||
+        header.version != version || header.header_size != sizeof(Header) ||
+        header.num_configs > (file->size() - sizeof(Header)) / (2 * sizeof(std::uint64_t)) ||
+        file->size() != sizeof(Header) + 2 * sizeof(std::uint64_t) * header.num_configs) {
+        throw invalid_argument(filename + " is not a binary knapsack instance.");
+    }
+    if (header.num_configs == 0 || header.max_items == 0) {
+        throw invalid_argument(filename + " does not hold any items or allows none in the knapsack.");
+    }
+    file->advise(MADV_WILLNEED);
+    const auto* weights = reinterpret_cast<const std::size_t*>(file->data() + sizeof(Header));
+    const auto* prices = weights + header.num_configs;
+    return {std::move(file), weights, prices, header.num_configs, header.max_weight, header.max_items};
+}
+
+Knapsack knapsack_io::load(const std::string& filename) {
+    char file_magic[sizeof(magic)] = {};
+    std::ifstream infile{filename, std::ios::binary};
+    if (!infile) {
+        throw runtime_error("Could not open the instance file " + filename + '.');
+    }
+    infile.read(file_magic, sizeof(file_magic));
+    infile.close();
+    return (std::memcmp(file_magic, magic, sizeof(magic)) == 0) ? load_binary(filename) : load_text(filename);
+}
+
+void knapsack_io::save_binary(const Knapsack& knapsack, const std::string& filename) {
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = version;
+    header.header_size = sizeof(Header);
+    header.num_configs = knapsack.num_configs();
+    header.max_weight = knapsack.max_weight();
+    header.max_items = knapsack.max_items();
+    std::ofstream outfile {filename, std::ios::trunc | std::ios::binary};
+    const auto array_size = static_cast<std::streamsize>(sizeof(std::size_t) * knapsack.num_configs());
+    outfile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outfile.write(reinterpret_cast<const char*>(knapsack.weights()), array_size);
+    outfile.write(reinterpret_cast<const char*>(knapsack.prices()), array_size);
+    if (!outfile) {
+        throw runtime_error("Could not write the instance file " + filename + '.');
+    }
+}
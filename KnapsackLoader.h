@@ -0,0 +1,49 @@
+#ifndef PROJECT_KNAPSACKLOADER_H
+#define PROJECT_KNAPSACKLOADER_H
+
+#include <cstdint>
+#include <string>
+
+#include "Knapsack.h"
+
+// Loading and saving of knapsack instances.
+//
+// Text instances use the OR-Library/Pisinger 0-1 knapsack layout: the number of items n and the capacity, followed
+// by n price/weight pairs, all whitespace separated. The file is memory mapped and parsed in place with
+// std::from_chars, so the only allocations are the knapsack's own weight and price arrays.
+//
+// Binary instances (written by save_binary) hold the weights and prices as raw 64-bit arrays behind a small header.
+// load_binary maps the file read-only and the knapsack uses the mapping directly as its configuration arrays -
+// nothing is parsed or copied, so even millions of items load in the time it takes to map the file.
+// The text format has no item limit, so such knapsacks get one equal to their number of items (never binding).
+namespace knapsack_io {
+    // Binary instance layout: header, weights[num_configs], prices[num_configs]. Native endian.
+    constexpr char magic[8] = {'G', 'A', 'K', 'N', 'A', 'P', 'S', 'K'};
+    constexpr std::uint32_t version = 1;
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t header_size;
+        std::uint64_t num_configs;
+        std::uint64_t max_weight;
+        std::uint64_t max_items;
+        std::uint64_t reserved[3];  // Pads the header to 64 bytes so the arrays start cache line aligned
+    };
+    static_assert(sizeof(Header) == 64, "The binary header is 64 bytes");
+    static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "The mapped arrays are used as std::size_t directly");
+
+    // Parses a text instance. Will throw if the file cannot be read, is malformed or holds no items.
+    [[nodiscard]] Knapsack load_text(const std::string& filename);
+
+    // Maps a binary instance. Will throw if the file cannot be mapped, is not a binary instance or holds no items
+    // (or allows none in the knapsack).
+    [[nodiscard]] Knapsack load_binary(const std::string& filename);
+
+    // Loads an instance in either format, telling them apart by the binary magic. Will throw as the loaders do.
+    [[nodiscard]] Knapsack load(const std::string& filename);
+
+    // Writes the knapsack as a binary instance. Will throw if the file cannot be written.
+    void save_binary(const Knapsack& knapsack, const std::string& filename);
+}
+#endif //PROJECT_KNAPSACKLOADER_H
@@ -0,0 +1,51 @@
+#ifndef PROJECT_MIGRATIONRING_H
+#define PROJECT_MIGRATIONRING_H
+
+#include <algorithm>    // std::copy_n
+#include <atomic>
+#include <vector>
+
+#include "PackedChromosome.h"
+
+// Lock-free single producer, single consumer ring of migrant batches. Each slot holds one batch of slot_words packed
+// words. The producer and consumer only share the two counters, which live on separate cache lines, so a push or a
+// pop is a copy plus one release store. A full ring rejects the batch instead of blocking the producer.
+class MigrationRing {
+public:
+    using Word = packed::Word;
+
+    MigrationRing(std::size_t capacity, std::size_t slot_words) :
+        slots_(capacity * slot_words), capacity_(capacity), slot_words_(slot_words) {}
+
+    // Producer side: copies a batch into the ring. Returns false (and drops the batch) if the ring is full.
+    bool try_push(const Word* batch) noexcept {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == capacity_) {
+            return false;
+        }
+        std::copy_n(batch, slot_words_, slots_.data() + (tail % capacity_) * slot_words_);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: copies the oldest batch out of the ring. Returns false if the ring is empty.
+    bool try_pop(Word* batch) noexcept {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        std::copy_n(slots_.data() + (head % capacity_) * slot_words_, slot_words_, batch);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    MigrationRing &operator=(const MigrationRing &) = delete;
+    MigrationRing(const MigrationRing &) = delete;
+private:
+    std::vector<Word> slots_;
+    const std::size_t capacity_;
+    const std::size_t slot_words_;
+    alignas(64) std::atomic<std::size_t> head_{0};  // Batches popped so far - written by the consumer only
+    alignas(64) std::atomic<std::size_t> tail_{0};  // Batches pushed so far - written by the producer only
+};
+#endif //PROJECT_MIGRATIONRING_H
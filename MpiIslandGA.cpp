@@ -0,0 +1,166 @@
+#ifdef GA_WITH_MPI
+
+#include <algorithm>    // std::min
+#include <random>       // std::seed_seq
+#include <stdexcept>    // std::invalid_argument
+#include <thread>       // std::thread::hardware_concurrency
+
+#include "MpiIslandGA.h"
+
+using std::invalid_argument; // If the migration or GA parameters are invalid
+
+namespace {
+    static_assert(sizeof(std::size_t) == sizeof(packed::Word), "Costs are sent as packed words");
+
+    // Seed of the island with the given global number. Only depends on the run seed and the island's place in the
+    // ring, so the islands of a run get the same seeds however often it is repeated.
+    std::size_t island_seed(std::size_t seed, std::size_t island) {
+        std::seed_seq seq{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                          static_cast<std::uint32_t>(island)};
+        std::uint32_t words[2];
+        seq.generate(std::begin(words), std::end(words));
+        return (static_cast<std::size_t>(words[0]) << 32) | words[1];
+    }
+}
+
+MpiIslandGA::MpiIslandGA(MPI_Comm comm, std::size_t islands_per_rank, std::size_t seed) :
+    comm_(comm)
+{
+    if (islands_per_rank == 0) {
+        throw invalid_argument("Every rank needs at least one island.");
+    }
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &num_ranks_);
+    const std::size_t first_island = static_cast<std::size_t>(rank_) * islands_per_rank;
+    for (std::size_t island_no = 0; island_no < islands_per_rank; ++island_no) {
+        islands_.push_back(std::make_unique<GA>(island_seed(seed, first_island + island_no)));
+    }
+    const std::size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    pool_ = std::make_unique<ThreadPool>(std::min(islands_per_rank, hardware_threads));
+}
+
+MpiIslandGA::~MpiIslandGA() {
+    if (!requests_.empty()) {
+        MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+    }
+}
+
+void MpiIslandGA::set_cf(const BinaryCostFunction* cf) {
+    for (auto& island : islands_) {
+        island->set_cf(cf);
+    }
+    cf_ = cf;
+    population_size_ = 0;
+}
+
+void MpiIslandGA::set_repair(const RepairOperator* repair) {
+    for (auto& island : islands_) {
+        island->set_repair(repair);
+    }
+}
+
+void MpiIslandGA::set_migration(std::size_t interval, std::size_t num_migrants) {
+    if (interval == 0 || !requests_.empty()) {
+        throw invalid_argument("The migration parameters are invalid.");
+    }
+    interval_ = interval;
+    num_migrants_ = num_migrants;
+    population_size_ = 0;
+}
+
+void MpiIslandGA::set_parameters(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate) {
+    if (num_migrants_ > pop_size) {
+        throw invalid_argument("More migrants than chromosomes in an island.");
+    }
+    for (auto& island : islands_) {
+        island->set_parameters(pop_size, num_elite, t_size, mutation_rate);
+    }
+    population_size_ = pop_size;
+    send_buffers_.assign(islands_.size(), std::vector<packed::Word>(message_words_()));
+    recv_buffers_.assign(islands_.size(), std::vector<packed::Word>(message_words_()));
+    requests_.reserve(2 * islands_.size());
+    update_best_();
+}
+
+// Epoch e's messages are posted when it ends and completed when epoch e + 1 ends
+void MpiIslandGA::new_population(std::size_t num_generations) {
+    if (population_size_ == 0) {
+        throw invalid_argument("The GA parameters have not been set.");
+    }
+    const bool migrate = num_islands() > 1 && num_migrants_ > 0;
+    for (std::size_t generation = 0; generation < num_generations;) {
+        const std::size_t epoch = std::min(interval_, num_generations - generation);
+        pool_->parallel_for(islands_.size(), [&](std::size_t island_no) { islands_[island_no]->new_population(epoch); });
+        generation += epoch;
+        if (migrate) {
+            complete_exchange_();
+            post_exchange_();
+        }
+    }
+    // Leave no messages in flight between calls
+    complete_exchange_();
+    update_best_();
+}
+
+std::size_t MpiIslandGA::message_words_() const noexcept {
+    return num_migrants_ * (1 + islands_.front()->words_per_chromosome());
+}
+
+// Local island l is global island g = rank * islands_per_rank + l. It sends to g + 1 and receives from g - 1, and
+// messages are tagged with the local number of the receiving island.
+void MpiIslandGA::post_exchange_() {
+    const std::size_t islands_per_rank = islands_.size();
+    const std::size_t num_islands = this->num_islands();
+    const int count = static_cast<int>(message_words_());
+    for (std::size_t island_no = 0; island_no < islands_per_rank; ++island_no) {
+        auto* message = send_buffers_[island_no].data();
+        islands_[island_no]->export_elites(num_migrants_, message + num_migrants_, reinterpret_cast<std::size_t*>(message));
+        const std::size_t target = (static_cast<std::size_t>(rank_) * islands_per_rank + island_no + 1) % num_islands;
+        requests_.emplace_back();
+        MPI_Isend(message, count, MPI_UINT64_T, static_cast<int>(target / islands_per_rank),
+                  static_cast<int>(target % islands_per_rank), comm_, &requests_.back());
+    }
+    for (std::size_t island_no = 0; island_no < islands_per_rank; ++island_no) {
+        const std::size_t source = (static_cast<std::size_t>(rank_) * islands_per_rank + island_no + num_islands - 1) % num_islands;
+        requests_.emplace_back();
+        MPI_Irecv(recv_buffers_[island_no].data(), count, MPI_UINT64_T, static_cast<int>(source / islands_per_rank),
+                  static_cast<int>(island_no), comm_, &requests_.back());
+    }
+}
+
+void MpiIslandGA::complete_exchange_() {
+    if (requests_.empty()) {
+        return;
+    }
+    MPI_Waitall(static_cast<int>(requests_.size()), requests_.data(), MPI_STATUSES_IGNORE);
+    requests_.clear();
+    pool_->parallel_for(islands_.size(), [&](std::size_t island_no) {
+        const auto* message = recv_buffers_[island_no].data();
+        islands_[island_no]->import_migrants(message + num_migrants_, num_migrants_,
+                                             reinterpret_cast<const std::size_t*>(message));
+    });
+}
+
+// Every rank contributes the best cost of its islands. The lowest rank with the highest cost broadcasts its
+// chromosome, so all ranks agree on the result.
+void MpiIslandGA::update_best_() {
+    const GA* local_best = nullptr;
+    std::size_t local_cost = 0;
+    for (const auto& island : islands_) {
+        if (const std::size_t cost = cf_->eval(island->get_best_packed()); !local_best || cost > local_cost) {
+            local_cost = cost;
+            local_best = island.get();
+        }
+    }
+    std::vector<packed::Word> costs(static_cast<std::size_t>(num_ranks_));
+    const packed::Word cost_word = local_cost;
+    MPI_Allgather(&cost_word, 1, MPI_UINT64_T, costs.data(), 1, MPI_UINT64_T, comm_);
+    const auto owner = static_cast<int>(std::max_element(std::begin(costs), std::end(costs)) - std::begin(costs));
+
+    const auto best = local_best->get_best_packed();
+    std::vector<packed::Word> words(best.words(), best.words() + best.num_words());
+    MPI_Bcast(words.data(), static_cast<int>(words.size()), MPI_UINT64_T, owner, comm_);
+    best_ = std::make_pair(static_cast<std::size_t>(costs[static_cast<std::size_t>(owner)]),
+                           BinaryCostFunction::unpack(PackedView(words.data(), best.num_genes())));
+}
+#endif //GA_WITH_MPI
@@ -0,0 +1,97 @@
+#ifndef PROJECT_MPIISLANDGA_H
+#define PROJECT_MPIISLANDGA_H
+
+// Only built when MPI is available, e.g.
+//   mpicxx -std=c++17 -O2 -pthread -DGA_WITH_MPI *.cpp -o ga_mpi && mpirun -np 8 ./ga_mpi
+#ifdef GA_WITH_MPI
+
+#include <memory>
+#include <utility>  // std::pair
+#include <vector>
+
+#include <mpi.h>
+
+#include "GA.h"
+#include "ThreadPool.h"
+
+// Distributed island model GA. Every MPI rank of the communicator runs islands_per_rank GA islands and all the
+// islands of all ranks form one migration ring: global island g = rank * islands_per_rank + local island sends its
+// best chromosomes to island g + 1 every interval generations.
+// Migrants are serialized as their costs followed by their packed genes and exchanged with non-blocking sends and
+// receives. The messages of one epoch are posted as soon as it ends and are only waited for at the end of the next
+// epoch, so communication overlaps a whole epoch of computation. Every island imports exactly one batch per epoch
+// (the batch its neighbour sent one epoch earlier), and island seeds are derived from the seed and the global island
+// number, so a run is reproducible for a given seed, number of ranks and islands per rank.
+// MPI must be initialized by the caller - with at least MPI_THREAD_FUNNELED when islands_per_rank > 1, since the
+// local islands evolve on a thread pool while only the calling thread communicates. All ranks must make the same
+// calls with the same parameters.
+class MpiIslandGA {
+public:
+    using Chromosome = BinaryCostFunction::Chromosome;
+
+    MpiIslandGA(MPI_Comm comm, std::size_t islands_per_rank, std::size_t seed);
+
+    // Completes any outstanding exchange
+    ~MpiIslandGA();
+
+    // Sets the cost function of every local island. Will throw if the cost function has not been configured.
+    void set_cf(const BinaryCostFunction* cf);
+
+    // Sets the repair operator of every local island - see GA::set_repair. Will throw if the islands' repair is fixed
+    // at compile time.
+    void set_repair(const RepairOperator* repair);
+
+    // Sets the number of generations between migrations and the number of chromosomes each island sends. 0 migrants
+    // disables migration. Set before set_parameters.
+    void set_migration(std::size_t interval, std::size_t num_migrants);
+
+    // Sets the parameters of every local island (see GA::set_parameters) and randomly initializes the populations
+    void set_parameters(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate);
+
+    // Evolves every island for num_generations generations. Collective over the communicator.
+    void new_population(std::size_t num_generations);
+
+    // Returns the cost of the best chromosome across all ranks - the same on every rank
+    [[nodiscard]] std::size_t get_best_cost() const noexcept { return best_.first; }
+
+    // Returns the best chromosome across all ranks - the same on every rank
+    [[nodiscard]] const Chromosome& get_best_chromosome() const noexcept { return best_.second; }
+
+    [[nodiscard]] int rank() const noexcept { return rank_; }
+    [[nodiscard]] std::size_t num_islands() const noexcept { return islands_.size() * static_cast<std::size_t>(num_ranks_); }
+
+    MpiIslandGA &operator=(const MpiIslandGA &) = delete;
+    MpiIslandGA(const MpiIslandGA &) = delete;
+private:
+    MPI_Comm comm_;
+    int rank_ = 0;
+    int num_ranks_ = 1;
+    const BinaryCostFunction* cf_ = nullptr;
+
+    std::vector<std::unique_ptr<GA>> islands_;
+    std::unique_ptr<ThreadPool> pool_;
+
+    std::size_t interval_ = 10;
+    std::size_t num_migrants_ = 1;
+    std::size_t population_size_ = 0;   // 0 until set_parameters has been called
+
+    // One outgoing and one incoming message per local island: num_migrants_ costs, then num_migrants_ chromosomes
+    std::vector<std::vector<packed::Word>> send_buffers_;
+    std::vector<std::vector<packed::Word>> recv_buffers_;
+    std::vector<MPI_Request> requests_;     // Sends then receives of the pending exchange - empty if none is pending
+
+    std::pair<std::size_t, Chromosome> best_;
+
+    [[nodiscard]] std::size_t message_words_() const noexcept;
+
+    // Serializes every local island's elites and posts the sends and receives of one epoch
+    void post_exchange_();
+
+    // Waits for the pending exchange and imports the received migrants
+    void complete_exchange_();
+
+    // Finds the best chromosome across all ranks and broadcasts it
+    void update_best_();
+};
+#endif //GA_WITH_MPI
+#endif //PROJECT_MPIISLANDGA_H
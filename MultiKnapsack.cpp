@@ -0,0 +1,115 @@
+#include <algorithm>    // std::copy, std::fill_n, std::max
+#include <stdexcept>    // std::invalid_argument
+
+#include "EvalKernel.h"
+#include "MultiKnapsack.h"
+
+using std::invalid_argument;    // If the dimensions or an item's weights are invalid, or the penalty is negative
+
+namespace {
+    [[nodiscard]] std::size_t padded(std::size_t num_dims) noexcept {
+        return (num_dims + eval_kernel::column_align - 1) / eval_kernel::column_align * eval_kernel::column_align;
+    }
+}
+
+MultiKnapsack::MultiKnapsack(std::size_t num_configurations, const std::vector<std::size_t>& capacities,
+                             std::size_t num_items) :
+        BinaryCostFunction(num_configurations),
+        num_dims_(capacities.size()),
+        stride_(padded(capacities.size())),
+        num_items_(num_items),
+        capacities_(stride_, std::numeric_limits<std::size_t>::max()),
+        columns_(num_configurations * stride_, 0),
+        prices_(num_configurations, 0)
+{
+    if (num_dims_ == 0 || num_dims_ > max_dims) {
+        throw invalid_argument("A multi-dimensional knapsack needs between 1 and 64 resource dimensions.");
+    }
+    std::copy(std::begin(capacities), std::end(capacities), std::begin(capacities_));
+}
+
+void MultiKnapsack::add_config(std::size_t price, const std::vector<std::size_t>& weights) {
+    if (weights.size() != num_dims_) {
+        throw invalid_argument("The item does not have a weight for every resource dimension.");
+    }
+    if (num_configs_ == num_vars()) {
+        throw invalid_argument("All the items of the knapsack have been added.");
+    }
+    std::copy(std::begin(weights), std::end(weights), columns_.begin() + num_configs_ * stride_);
+    prices_[num_configs_++] = price;
+}
+
+// The item limit is checked up front from the popcount; the resources after every word of genes
+MultiKnapsack::Evaluation MultiKnapsack::evaluate(PackedView chromosome) const noexcept {
+    const std::size_t count = chromosome.count();
+    if (count > num_items_) {
+        return {0, false, num_dims_};
+    }
+    alignas(32) std::size_t load[max_dims];
+    std::fill_n(load, stride_, 0);
+    std::size_t cost = 0;
+    const auto* words = chromosome.words();
+    for (std::size_t w = 0; w < chromosome.num_words(); ++w) {
+        const std::size_t base = w * packed::bits_per_word;
+        cost += eval_kernel::add_columns(words + w, 1, columns_.data() + base * stride_, stride_, prices_.data() + base, load);
+        if (const auto dim = eval_kernel::first_violation(load, capacities_.data(), stride_); dim != stride_) {
+            return {0, false, dim};
+        }
+    }
+    return {cost, true, no_violation};
+}
+
+std::size_t MultiKnapsack::eval(const Chromosome& chromosome) const {
+    return MultiKnapsack::eval(pack(chromosome).view());
+}
+
+std::size_t MultiKnapsack::eval(PackedView chromosome) const noexcept {
+    const auto evaluation = evaluate(chromosome);
+    return evaluation.feasible || penalty_ == 0. ? evaluation.cost : penalized_(chromosome);
+}
+
+void MultiKnapsack::eval_batch(const packed::Word* genes, std::size_t words_per_chromosome, std::size_t num_chromosomes,
+                               std::size_t* costs) const noexcept {
+    for (std::size_t chromosome_no = 0; chromosome_no < num_chromosomes; ++chromosome_no) {
+        costs[chromosome_no] = MultiKnapsack::eval(PackedView(genes + chromosome_no * words_per_chromosome, num_vars()));
+    }
+}
+
+void MultiKnapsack::set_penalty(double penalty) {
+    if (penalty < 0.) {
+        throw invalid_argument("The penalty cannot be negative.");
+    }
+    penalty_ = penalty;
+}
+
+std::size_t MultiKnapsack::add_load(PackedView chromosome, std::size_t* load) const noexcept {
+    return eval_kernel::add_columns(chromosome.words(), chromosome.num_words(), columns_.data(), stride_,
+                                    prices_.data(), load);
+}
+
+std::size_t MultiKnapsack::violation(const std::size_t* load, std::size_t count) const noexcept {
+    if (count > num_items_) {
+        return num_dims_;
+    }
+    const auto dim = eval_kernel::first_violation(load, capacities_.data(), stride_);
+    return dim == stride_ ? no_violation : dim;
+}
+
+bool MultiKnapsack::fits(const std::size_t* load, std::size_t count, std::size_t gene) const noexcept {
+    return count < num_items_ && eval_kernel::fits(load, column(gene), capacities_.data(), stride_);
+}
+
+std::size_t MultiKnapsack::penalized_(PackedView chromosome) const noexcept {
+    alignas(32) std::size_t load[max_dims];
+    std::fill_n(load, stride_, 0);
+    const std::size_t price = add_load(chromosome, load);
+    const std::size_t count = chromosome.count();
+    const auto relative = [](std::size_t used, std::size_t limit) {
+        return used > limit ? static_cast<double>(used - limit) / static_cast<double>(std::max<std::size_t>(1, limit)) : 0.;
+    };
+    double excess = relative(count, num_items_);
+    for (std::size_t dim = 0; dim < num_dims_; ++dim) {
+        excess += relative(load[dim], capacities_[dim]);
+    }
+    return std::max<std::size_t>(1, static_cast<std::size_t>(static_cast<double>(price) / (1. + penalty_ * excess)));
+}
@@ -0,0 +1,88 @@
+#ifndef PROJECT_MULTIKNAPSACK_H
+#define PROJECT_MULTIKNAPSACK_H
+
+#include <limits>
+#include <vector>
+
+#include "BinaryCostFunction.h"
+
+// Multi-dimensional 0-1 knapsack: every item uses some of each of num_dims resources, each with its own capacity,
+// plus an optional limit on the number of items. The constraint matrix is stored column-major - the weights of one
+// item are contiguous and padded to a vector multiple - so adding an item to a load is a few vector adds and all the
+// constraints are checked in one vectorized pass (see eval_kernel::add_columns).
+// Unfeasible chromosomes cost 0 so the GA repairs them (see MultiKnapsackRepair), unless a penalty is set, in which
+// case they get a penalized nonzero cost and are kept in the population instead.
+class MultiKnapsack : public BinaryCostFunction {
+public:
+    // Most resource dimensions supported - loads of this size live on the stack
+    static constexpr std::size_t max_dims = 64;
+    // violated_dim of a feasible chromosome
+    static constexpr std::size_t no_violation = std::numeric_limits<std::size_t>::max();
+
+    // Result of evaluate. violated_dim is a resource dimension in [0, num_dims), num_dims() for the item limit, or
+    // no_violation when the chromosome is feasible.
+    struct Evaluation {
+        std::size_t cost = 0;           // Total price of the In items, 0 when unfeasible
+        bool feasible = true;
+        std::size_t violated_dim = no_violation;
+    };
+
+    // Creates a knapsack for num_configurations items with one capacity per resource dimension and the maximum
+    // number of items it can hold. Will throw if there are no dimensions or more than max_dims.
+    MultiKnapsack(std::size_t num_configurations, const std::vector<std::size_t>& capacities, std::size_t num_items);
+
+    // Adds the next item: its price and its weight in every dimension. Will throw if the weights are not num_dims
+    // long or all the items have been added.
+    void add_config(std::size_t price, const std::vector<std::size_t>& weights);
+
+    // Evaluates the chromosome. Stops at the first word of genes after which a constraint is violated, since
+    // weights cannot make it feasible again, and reports that constraint.
+    [[nodiscard]] Evaluation evaluate(PackedView chromosome) const noexcept;
+
+    // The cost the GA sees: evaluate's cost, or the penalized cost for an unfeasible chromosome when a penalty is set
+    [[nodiscard]] std::size_t eval(const Chromosome& chromosome) const override;
+    [[nodiscard]] std::size_t eval(PackedView chromosome) const noexcept override;
+    void eval_batch(const packed::Word* genes, std::size_t words_per_chromosome, std::size_t num_chromosomes,
+                    std::size_t* costs) const noexcept override;
+
+    // Penalty fitness as an alternative to repair: an unfeasible chromosome costs its total price divided by
+    // 1 + penalty * its relative excess (the excess over each capacity as a fraction of it, summed over the
+    // dimensions and the item limit), and at least 1 so the GA does not repair it. Dividing keeps unfeasible
+    // chromosomes ordered however far over they are. 0 (the default) turns it off. With a small penalty the GA's
+    // best chromosome may be unfeasible - check it with evaluate. Will throw if negative.
+    void set_penalty(double penalty);
+    [[nodiscard]] double penalty() const noexcept { return penalty_; }
+
+    // Adds the columns of the In genes to load[0, stride()) and returns their total price - the full load, with no
+    // early exit
+    std::size_t add_load(PackedView chromosome, std::size_t* load) const noexcept;
+
+    // The constraint a load of count items violates (as Evaluation::violated_dim), checked in one vectorized pass
+    [[nodiscard]] std::size_t violation(const std::size_t* load, std::size_t count) const noexcept;
+
+    // Returns true if adding the gene to a load of count items keeps it feasible
+    [[nodiscard]] bool fits(const std::size_t* load, std::size_t count, std::size_t gene) const noexcept;
+
+    // Accessors. column(gene) holds the gene's weight in every dimension, followed by zero padding up to stride().
+    [[nodiscard]] std::size_t num_dims() const noexcept { return num_dims_; }
+    [[nodiscard]] std::size_t stride() const noexcept { return stride_; }
+    [[nodiscard]] std::size_t capacity(std::size_t dim) const noexcept { return capacities_[dim]; }
+    [[nodiscard]] std::size_t max_items() const noexcept { return num_items_; }
+    [[nodiscard]] const std::size_t* column(std::size_t gene) const noexcept { return columns_.data() + gene * stride_; }
+    [[nodiscard]] std::size_t weight(std::size_t gene, std::size_t dim) const noexcept { return column(gene)[dim]; }
+    [[nodiscard]] std::size_t price(std::size_t gene) const noexcept { return prices_[gene]; }
+    [[nodiscard]] std::size_t num_configs() const noexcept { return num_configs_; }
+private:
+    // Cost of an unfeasible chromosome with a penalty set
+    [[nodiscard]] std::size_t penalized_(PackedView chromosome) const noexcept;
+
+    const std::size_t num_dims_;
+    const std::size_t stride_;              // num_dims_ rounded up to eval_kernel::column_align
+    const std::size_t num_items_;           // The maximum number of items that can be stored in the backpack
+    std::vector<std::size_t> capacities_;   // stride_ entries, the padding is the maximum std::size_t
+    std::vector<std::size_t> columns_;      // num_vars columns of stride_ weights - column-major constraint matrix
+    std::vector<std::size_t> prices_;
+    std::size_t num_configs_ = 0;           // Items added so far
+    double penalty_ = 0.;
+};
+#endif //PROJECT_MULTIKNAPSACK_H
@@ -0,0 +1,181 @@
+#ifndef PROJECT_PACKEDCHROMOSOME_H
+#define PROJECT_PACKEDCHROMOSOME_H
+
+#include <cstdint>  // std::uint64_t
+#include <cstddef>  // std::size_t
+#include <vector>
+
+// Bit-packed chromosome storage: 64 genes per word, gene i lives at bit (i % 64) of word (i / 64) and a set bit
+// means the gene is In. Bits past the last gene of the final word are always kept at zero so that whole words can
+// be compared, counted and hashed without masking.
+namespace packed {
+    using Word = std::uint64_t;
+    constexpr std::size_t bits_per_word = 64;
+
+    // Number of words needed to store num_genes genes
+    constexpr std::size_t num_words(std::size_t num_genes) noexcept { return (num_genes + bits_per_word - 1) / bits_per_word; }
+
+    // Word index and bit mask of the given gene
+    constexpr std::size_t word_index(std::size_t gene) noexcept { return gene / bits_per_word; }
+    constexpr Word bit_mask(std::size_t gene) noexcept { return Word{1} << (gene % bits_per_word); }
+
+    // Mask of bits [first, last) within a single word. Requires first <= last <= 64.
+    constexpr Word range_mask(std::size_t first, std::size_t last) noexcept {
+        const Word upper = (last == bits_per_word) ? ~Word{0} : (Word{1} << last) - 1;
+        return upper & ~((Word{1} << first) - 1);
+    }
+
+    // Mask of the bits of the final word that hold genes
+    constexpr Word tail_mask(std::size_t num_genes) noexcept {
+        const std::size_t used = num_genes % bits_per_word;
+        return (used == 0) ? ~Word{0} : range_mask(0, used);
+    }
+
+    // Index of the lowest set bit. The word must not be zero.
+    inline std::size_t lowest_bit(Word word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+        std::size_t index = 0;
+        while (!(word & 1)) { word >>= 1; ++index; }
+        return index;
+#endif
+    }
+
+    // Index of the highest set bit. The word must not be zero.
+    inline std::size_t highest_bit(Word word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return bits_per_word - 1 - static_cast<std::size_t>(__builtin_clzll(word));
+#else
+        std::size_t index = 0;
+        while (word >>= 1) { ++index; }
+        return index;
+#endif
+    }
+
+    // Number of set bits in the word
+    inline std::size_t popcount(Word word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+        std::size_t count = 0;
+        for (; word; word &= word - 1) { ++count; }
+        return count;
+#endif
+    }
+
+    // Single point crossover as masked word copies: dst receives genes [0, mid) from p1 and [mid, num_genes) from p2.
+    // dst may alias either parent.
+    inline void splice(Word* dst, const Word* p1, const Word* p2, std::size_t num_genes, std::size_t mid) noexcept {
+        const std::size_t words = num_words(num_genes);
+        const std::size_t mid_word = word_index(mid);
+        for (std::size_t w = 0; w < mid_word; ++w) { dst[w] = p1[w]; }
+        if (mid_word < words) {
+            const Word low = range_mask(0, mid % bits_per_word);
+            dst[mid_word] = (p1[mid_word] & low) | (p2[mid_word] & ~low);
+        }
+        for (std::size_t w = mid_word + 1; w < words; ++w) { dst[w] = p2[w]; }
+    }
+}
+
+// Read-only view of a packed chromosome. Cheap to copy - pass by value.
+class PackedView {
+public:
+    using Word = packed::Word;
+
+    constexpr PackedView(const Word* words, std::size_t num_genes) noexcept : words_(words), num_genes_(num_genes) {}
+
+    // Returns true if the gene is In
+    [[nodiscard]] bool test(std::size_t gene) const noexcept {
+        return words_[packed::word_index(gene)] & packed::bit_mask(gene);
+    }
+
+    // Number of In genes
+    [[nodiscard]] std::size_t count() const noexcept {
+        std::size_t total = 0;
+        for (std::size_t w = 0; w < num_words(); ++w) { total += packed::popcount(words_[w]); }
+        return total;
+    }
+
+    [[nodiscard]] std::size_t num_genes() const noexcept { return num_genes_; }
+    [[nodiscard]] std::size_t num_words() const noexcept { return packed::num_words(num_genes_); }
+    [[nodiscard]] const Word* words() const noexcept { return words_; }
+private:
+    const Word* words_;
+    std::size_t num_genes_;
+};
+
+// Mutable view of a packed chromosome that lives in someone else's storage (e.g. a population arena).
+class PackedRef {
+public:
+    using Word = packed::Word;
+
+    constexpr PackedRef(Word* words, std::size_t num_genes) noexcept : words_(words), num_genes_(num_genes) {}
+
+    [[nodiscard]] bool test(std::size_t gene) const noexcept {
+        return words_[packed::word_index(gene)] & packed::bit_mask(gene);
+    }
+    void set(std::size_t gene) const noexcept { words_[packed::word_index(gene)] |= packed::bit_mask(gene); }
+    void reset(std::size_t gene) const noexcept { words_[packed::word_index(gene)] &= ~packed::bit_mask(gene); }
+    void flip(std::size_t gene) const noexcept { words_[packed::word_index(gene)] ^= packed::bit_mask(gene); }
+
+    // Clears the bits past the final gene. Must be called after writing whole words into data().
+    void trim() const noexcept {
+        if (num_genes_ != 0) { words_[num_words() - 1] &= packed::tail_mask(num_genes_); }
+    }
+
+    [[nodiscard]] std::size_t num_genes() const noexcept { return num_genes_; }
+    [[nodiscard]] std::size_t num_words() const noexcept { return packed::num_words(num_genes_); }
+    [[nodiscard]] Word* data() const noexcept { return words_; }
+
+    [[nodiscard]] PackedView view() const noexcept { return {words_, num_genes_}; }
+    operator PackedView() const noexcept { return view(); }
+private:
+    Word* words_;
+    std::size_t num_genes_;
+};
+
+// Owning bit-packed chromosome. Uses 1/32 of the memory of a std::vector<Gene> of the same length.
+class PackedChromosome {
+public:
+    using Word = packed::Word;
+
+    PackedChromosome() = default;
+
+    // Creates a chromosome with all genes Out
+    explicit PackedChromosome(std::size_t num_genes) : words_(packed::num_words(num_genes)), num_genes_(num_genes) {}
+
+    // Copies the genes of a view
+    explicit PackedChromosome(PackedView genes) :
+        words_(genes.words(), genes.words() + genes.num_words()), num_genes_(genes.num_genes()) {}
+
+    [[nodiscard]] bool test(std::size_t gene) const noexcept {
+        return words_[packed::word_index(gene)] & packed::bit_mask(gene);
+    }
+    void set(std::size_t gene) noexcept { words_[packed::word_index(gene)] |= packed::bit_mask(gene); }
+    void reset(std::size_t gene) noexcept { words_[packed::word_index(gene)] &= ~packed::bit_mask(gene); }
+    void flip(std::size_t gene) noexcept { words_[packed::word_index(gene)] ^= packed::bit_mask(gene); }
+
+    // Clears the bits past the final gene. Must be called after writing whole words into data().
+    void trim() noexcept {
+        if (!words_.empty()) { words_.back() &= packed::tail_mask(num_genes_); }
+    }
+
+    [[nodiscard]] std::size_t count() const noexcept { return view().count(); }
+    [[nodiscard]] std::size_t num_genes() const noexcept { return num_genes_; }
+    [[nodiscard]] std::size_t num_words() const noexcept { return words_.size(); }
+    [[nodiscard]] Word* data() noexcept { return words_.data(); }
+    [[nodiscard]] const Word* data() const noexcept { return words_.data(); }
+
+    [[nodiscard]] PackedView view() const noexcept { return {words_.data(), num_genes_}; }
+    operator PackedView() const noexcept { return view(); }
+
+    friend bool operator==(const PackedChromosome& lhs, const PackedChromosome& rhs) noexcept {
+        return lhs.num_genes_ == rhs.num_genes_ && lhs.words_ == rhs.words_;
+    }
+    friend bool operator!=(const PackedChromosome& lhs, const PackedChromosome& rhs) noexcept { return !(lhs == rhs); }
+private:
+    std::vector<Word> words_;
+    std::size_t num_genes_ = 0;
+};
+#endif //PROJECT_PACKEDCHROMOSOME_H
@@ -0,0 +1,117 @@
+#include <algorithm>    // std::max
+#include <charconv>     // std::to_chars
+#include <random>       // Run seeds
+#include <stdexcept>    // std::invalid_argument
+
+#include "KnapsackLoader.h"
+#include "ParameterSweep.h"
+#include "ResultsSink.h"
+
+using std::invalid_argument;    // If a grid point has invalid parameters
+
+namespace {
+    // Appends the text form of a number to a row's leading values
+    template <typename T>
+    void append(std::string& row, T value) {
+        char digits[32];
+        const auto [end, error] = std::to_chars(std::begin(digits), std::end(digits), value);
+        row.append(digits, end);
+    }
+}
+
+// Expanded instance first, then pop_size, num_elite, t_size, mutation_rate and num_gens, so a point's runs are
+// consecutive jobs. The seeds are drawn in job order from one generator, so only the config decides them.
+ParameterSweep::ParameterSweep(const SweepConfig& config) :
+    config_(config),
+    batch_(config.num_workers)
+{
+    if (config_.num_runs == 0) {
+        throw invalid_argument("A sweep needs at least one run per point.");
+    }
+    instances_.reserve(config_.instances.size());
+    for (const auto& filename : config_.instances) {
+        instances_.push_back(knapsack_io::load(filename));
+    }
+    std::mt19937_64 seeds{config_.seed ? *config_.seed : std::random_device{}()};
+    for (std::size_t instance = 0; instance < instances_.size(); ++instance) {
+        for (const auto pop_size : config_.pop_sizes) {
+            for (const auto num_elite : config_.num_elites) {
+                for (const auto t_size : config_.t_sizes) {
+                    for (const auto mutation_rate : config_.mutation_rates) {
+                        for (const auto num_gens : config_.num_gens) {
+                            // The checks of GA::set_parameters, made before anything runs
+                            if (pop_size == 0 || num_elite >= pop_size || t_size == 0 || mutation_rate > 1. ||
+                                mutation_rate < 0. || num_gens == 0) {
+                                throw invalid_argument("Invalid parameters: pop_size " + std::to_string(pop_size) +
+                                                       ", num_elite " + std::to_string(num_elite) +
+                                                       ", t_size " + std::to_string(t_size) +
+                                                       ", mutation_rate " + std::to_string(mutation_rate) +
+                                                       ", num_gens " + std::to_string(num_gens) + '.');
+                            }
+                            const BatchRunner::Parameters parameters{pop_size, num_elite, t_size, mutation_rate, num_gens};
+                            points_.push_back({instance, parameters, batch_.num_jobs()});
+                            for (std::size_t run_no = 0; run_no < config_.num_runs; ++run_no) {
+                                batch_.add_job({&instances_[instance], parameters, static_cast<std::size_t>(seeds())});
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ParameterSweep::run() {
+    batch_.run();
+}
+
+// Every run goes through one CSV sink, padded to the longest num_gens of the grid
+void ParameterSweep::write_results(const std::string& filename) const {
+    ResultsHeader header;
+    for (const auto num_gens : config_.num_gens) {
+        header.num_gens = std::max(header.num_gens, num_gens);
+    }
+    header.num_runs = num_jobs();
+    CsvResultsSink sink;
+    sink.set_leading_columns("instance,pop_size,num_elite,t_size,mutation_rate,num_gens,seed,best_cost");
+    sink.open(filename, header);
+    std::string values;
+    for (const auto& [instance, parameters, first_job] : points_) {
+        for (std::size_t run_no = 0; run_no < config_.num_runs; ++run_no) {
+            const auto& result = batch_.result(first_job + run_no);
+            values = config_.instances[instance];
+            for (const auto value : {parameters.pop_size, parameters.num_elite, parameters.t_size}) {
+                values += ',';
+                append(values, value);
+            }
+            values += ',';
+            append(values, parameters.mutation_rate);
+            for (const auto value : {parameters.num_gens, batch_.job(first_job + run_no).seed, result.best_cost}) {
+                values += ',';
+                append(values, value);
+            }
+            // Solution generations are 1-based, as in the other results files
+            sink.write_run(values, run_no, result.solution_generation+1, result.best_costs.data(), result.best_costs.size());
+        }
+    }
+    sink.close();
+}
+
+std::ostream& ParameterSweep::print_summary(std::ostream& os) const {
+    for (const auto& [instance, parameters, first_job] : points_) {
+        std::size_t best = 0;
+        double mean = 0.;
+        double mean_generation = 0.;
+        for (std::size_t run_no = 0; run_no < config_.num_runs; ++run_no) {
+            const auto& result = batch_.result(first_job + run_no);
+            best = std::max(best, result.best_cost);
+            mean += static_cast<double>(result.best_cost) / config_.num_runs;
+            mean_generation += static_cast<double>(result.solution_generation+1) / config_.num_runs;
+        }
+        os << config_.instances[instance] << " pop_size " << parameters.pop_size << " num_elite " << parameters.num_elite
+           << " t_size " << parameters.t_size << " mutation_rate " << parameters.mutation_rate
+           << " num_gens " << parameters.num_gens << ": best " << best << ", mean " << mean
+           << ", mean solution generation " << mean_generation << '\n';
+    }
+    return os;
+}
@@ -0,0 +1,52 @@
+#ifndef PROJECT_PARAMETERSWEEP_H
+#define PROJECT_PARAMETERSWEEP_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "BatchRunner.h"
+#include "Knapsack.h"
+#include "SweepConfig.h"
+
+// Runs a SweepConfig: loads the instance files, expands the parameter grid into batch runner jobs (runs of the same
+// grid point are consecutive jobs), runs them all concurrently and writes every run to one consolidated results
+// file. Seeded sweeps are reproducible for any number of workers.
+class ParameterSweep {
+public:
+    // One combination of an instance and GA parameters
+    struct Point {
+        std::size_t instance = 0;               // Index into the config's instances
+        BatchRunner::Parameters parameters;
+        std::size_t first_job = 0;              // The point's runs are jobs [first_job, first_job + num_runs)
+    };
+
+    // Loads the instances and queues the jobs. Will throw if an instance cannot be loaded or a grid point has
+    // invalid parameters.
+    explicit ParameterSweep(const SweepConfig& config);
+
+    // Runs every job
+    void run();
+
+    // Writes every run to one CSV file through CsvResultsSink. Each row starts with the point's instance and
+    // parameters, the run's seed and best cost, followed by the sink's columns: the run number, the 1-based generation
+    // the best cost was found in and the best cost of every generation, padded to the largest num_gens of the grid.
+    // The mutation rate is the requested one. Will throw if the file cannot be created.
+    void write_results(const std::string& filename) const;
+
+    // Prints the best and mean best cost and the mean solution generation of every point
+    std::ostream& print_summary(std::ostream& os) const;
+
+    [[nodiscard]] std::size_t num_points() const noexcept { return points_.size(); }
+    [[nodiscard]] const Point& point(std::size_t point_no) const noexcept { return points_[point_no]; }
+    [[nodiscard]] std::size_t num_jobs() const noexcept { return batch_.num_jobs(); }
+
+    ParameterSweep &operator=(const ParameterSweep &) = delete;
+    ParameterSweep(const ParameterSweep &) = delete;
+private:
+    SweepConfig config_;
+    std::vector<Knapsack> instances_;   // Never resized once jobs point into it
+    std::vector<Point> points_;
+    BatchRunner batch_;
+};
+#endif //PROJECT_PARAMETERSWEEP_H
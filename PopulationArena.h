@@ -0,0 +1,89 @@
+#ifndef PROJECT_POPULATIONARENA_H
+#define PROJECT_POPULATIONARENA_H
+
+#include <algorithm>    // std::copy_n
+#include <utility>      // std::swap
+#include <vector>
+
+#include "BinaryCostFunction.h"
+#include "PackedChromosome.h"
+
+// Structure-of-arrays population store. All chromosomes live in one contiguous buffer of
+// pop_size * words_per_chromosome packed words, and the per-chromosome data (costs and, for cost functions that
+// support them, the running weight/value/count totals) lives in parallel arrays indexed by the chromosome number.
+// The GA keeps two arenas and swaps them every generation so no chromosome is ever allocated or copy-constructed
+// in the generation loop.
+// Each chromosome also has a dirty flag, set when its genes have changed since its cost was last computed, so only
+// dirty chromosomes need to be evaluated.
+class PopulationArena {
+public:
+    using Word = packed::Word;
+    using Totals = BinaryCostFunction::Totals;
+
+    PopulationArena() = default;
+
+    // Sizes the arena for pop_size chromosomes of num_genes genes each. All genes are cleared.
+    // Existing capacity is reused, so resizing to the same (or a smaller) shape does not allocate.
+    void resize(std::size_t pop_size, std::size_t num_genes) {
+        size_ = pop_size;
+        num_genes_ = num_genes;
+        stride_ = packed::num_words(num_genes);
+        genes_.assign(size_ * stride_, Word{0});
+        costs_.assign(size_, 0);
+        totals_.assign(size_, Totals{});
+        dirty_.assign(size_, 1);
+    }
+
+    // Copies chromosome src_no of another (same shaped) arena, its cost and its totals into slot dst_no
+    void copy_from(const PopulationArena& other, std::size_t src_no, std::size_t dst_no) noexcept {
+        std::copy_n(other.words(src_no), stride_, words(dst_no));
+        costs_[dst_no] = other.costs_[src_no];
+        totals_[dst_no] = other.totals_[src_no];
+        dirty_[dst_no] = other.dirty_[src_no];
+    }
+
+    // O(1) exchange of the contents of two arenas
+    void swap(PopulationArena& other) noexcept {
+        genes_.swap(other.genes_);
+        costs_.swap(other.costs_);
+        totals_.swap(other.totals_);
+        dirty_.swap(other.dirty_);
+        std::swap(size_, other.size_);
+        std::swap(num_genes_, other.num_genes_);
+        std::swap(stride_, other.stride_);
+    }
+
+    // Accessors for the chromosome with the given number
+    [[nodiscard]] PackedRef operator[](std::size_t chromosome_no) noexcept { return {words(chromosome_no), num_genes_}; }
+    [[nodiscard]] PackedView operator[](std::size_t chromosome_no) const noexcept { return {words(chromosome_no), num_genes_}; }
+    [[nodiscard]] Word* words(std::size_t chromosome_no) noexcept { return genes_.data() + chromosome_no * stride_; }
+    [[nodiscard]] const Word* words(std::size_t chromosome_no) const noexcept { return genes_.data() + chromosome_no * stride_; }
+
+    // Cost of the chromosome with the given number
+    [[nodiscard]] std::size_t& cost(std::size_t chromosome_no) noexcept { return costs_[chromosome_no]; }
+    [[nodiscard]] std::size_t cost(std::size_t chromosome_no) const noexcept { return costs_[chromosome_no]; }
+    [[nodiscard]] std::size_t* costs() noexcept { return costs_.data(); }
+    [[nodiscard]] const std::size_t* costs() const noexcept { return costs_.data(); }
+
+    // Cached running totals of the chromosome with the given number
+    [[nodiscard]] Totals& totals(std::size_t chromosome_no) noexcept { return totals_[chromosome_no]; }
+    [[nodiscard]] const Totals& totals(std::size_t chromosome_no) const noexcept { return totals_[chromosome_no]; }
+
+    // Whether the chromosome's genes have changed since its cost was computed
+    [[nodiscard]] bool is_dirty(std::size_t chromosome_no) const noexcept { return dirty_[chromosome_no]; }
+    void mark_dirty(std::size_t chromosome_no, bool dirty = true) noexcept { dirty_[chromosome_no] = dirty; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t num_genes() const noexcept { return num_genes_; }
+    [[nodiscard]] std::size_t words_per_chromosome() const noexcept { return stride_; }
+private:
+    std::vector<Word>           genes_;     // pop_size * stride_ words, chromosome i starts at i * stride_
+    std::vector<std::size_t>    costs_;     // Cost/fitness of each chromosome
+    std::vector<Totals>         totals_;    // Running weight/value/count totals of each chromosome
+    std::vector<unsigned char>  dirty_;     // Non-zero if the chromosome needs evaluating - bytes, so threads can
+                                            // flag different chromosomes concurrently
+    std::size_t size_ = 0;                  // Number of chromosomes
+    std::size_t num_genes_ = 0;             // Genes per chromosome
+    std::size_t stride_ = 0;                // Words per chromosome
+};
+#endif //PROJECT_POPULATIONARENA_H
@@ -0,0 +1,23 @@
+#ifndef PROJECT_PROGRESSOBSERVER_H
+#define PROJECT_PROGRESSOBSERVER_H
+
+#include <cstddef>
+
+#include "PackedChromosome.h"
+
+// Receives the progress of a running GA (see GA::set_progress_observer). Called on the thread running
+// new_population every time a generation's best cost is recorded, so it is on the generation loop: it must be cheap,
+// must not allocate per call and must not call back into the GA.
+class ProgressObserver {
+public:
+    // Generation of the final population of a run, which AsyncSolver reports although it has no record in
+    // GA::get_best_costs()
+    static constexpr std::size_t final_population = static_cast<std::size_t>(-1);
+
+    virtual ~ProgressObserver() = default;
+
+    // generation is the index of the record in GA::get_best_costs(), or final_population. best is the best
+    // chromosome, only valid during the call.
+    virtual void on_progress(std::size_t generation, std::size_t best_cost, PackedView best) noexcept = 0;
+};
+#endif //PROJECT_PROGRESSOBSERVER_H
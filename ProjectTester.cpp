@@ -4,6 +4,8 @@
 #include <array>    // solve all
 #include <iostream> // display results
 #include <fstream>  // create output file
+#include <random>   // batch run seeds, solver check instances
+#include <vector>
 
 using config = std::pair<std::size_t, std::size_t>;
 
@@ -52,22 +54,38 @@ void ProjectTester::create_outfile(const std::string& filename) {
     outfile.close();
 }
 
+// With an output file the runs of every knapsack are queued on the batch runner and evolved concurrently, then each
+// knapsack's results file is written in one go.
 void ProjectTester::solve_all(std::size_t num_gens, std::size_t num_runs, const std::optional<const std::string>& filename) {
     Knapsack cf6(150, 7500, 150);
     cf6.random_configs();
     std::array cfs{cf1, cf2, cf3, cf4, cf5};
+    if (filename) {
+        batch.clear();
+        std::mt19937_64 seeds{seed_ ? *seed_ : std::random_device{}()};
+        const BatchRunner::Parameters parameters{pop_size_, num_elite_, t_size_, mutation_rate_, num_gens};
+        for (const auto& cf : cfs) {
+            for (std::size_t i = 0; i < num_runs; ++i) {
+                batch.add_job({&cf, parameters, static_cast<std::size_t>(seeds())});
+            }
+        }
+        Timer timer;
+        batch.run();
+        timer.time("GA batch time: ");
+    }
     std::size_t backpack = 0;
     for (const auto& cf : cfs) {
         std::cout << "Evolving Knapsack " << ++backpack << '\n';
         if (filename) {
             std::string name = std::to_string(backpack) + 'r' + *filename;
-            ga.set_cf(&cf);
-            ga.set_parameters(pop_size_, num_elite_, t_size_, mutation_rate_);
-            ga.prep_outfile(name, num_gens, num_runs);
-            for (std::size_t i = 0; i < num_runs; ++i) {
-                solve_(num_gens, name, &cf);
+            const std::size_t first_job = (backpack - 1) * num_runs;
+            batch.write_results(sink_(), name, first_job, num_runs);
+            for (std::size_t job_no = first_job; job_no < first_job + num_runs; ++job_no) {
+                std::cout << "GA best solution: " << batch.result(job_no).best_cost << '\n';
             }
             bf_solve(&cf);
+            dp_solve(cf);
+            bb_solve(cf);
             greedy_solve(cf);
         } else {
             solve_(num_gens, filename, &cf);
@@ -87,6 +105,8 @@ void ProjectTester::solve_random(std::size_t num_gens, std::size_t max_weight, s
     std::cout << "Evolving a random backpack with a max weight of " << max_weight << " and a max capacity of " << num_items << " items.\n";
     solve_(num_gens, filename, &cf);
     greedy_solve(cf);
+    dp_solve(cf);
+    bb_solve(cf, ga.get_best_chromosome());
     if (bf_solve) {
         std::cout << "\nSolving by brute force.\n";
         this->bf_solve(&cf);
@@ -96,15 +116,119 @@ void ProjectTester::solve_random(std::size_t num_gens, std::size_t max_weight, s
 void ProjectTester::bf_solve(const BinaryCostFunction* cf) {
     Timer timer;
     bf.set_cf(cf);
+    // Exhaustive search over Gray codes on all cores whenever the cost function allows it
+    bf.set_mode(cf->supports_totals() ? BruteForce::Mode::GrayCode : BruteForce::Mode::Batch);
+    bf.set_num_threads(0);
     bf.solve();
     bf.print(std::cout);
     timer.time("BF time: ");
 }
 
+void ProjectTester::dp_solve(const Knapsack& knapsack) {
+    Timer timer;
+    dp.set_cf(&knapsack);
+    dp.solve();
+    dp.print(std::cout);
+    timer.time("DP time: ");
+}
+
+void ProjectTester::bb_solve(const Knapsack& knapsack, const std::optional<BinaryCostFunction::Chromosome>& incumbent) {
+    Timer timer;
+    bb.set_cf(&knapsack);
+    if (incumbent) {
+        bb.set_incumbent(*incumbent);
+    }
+    bb.set_num_threads(0);
+    bb.solve();
+    bb.print(std::cout);
+    timer.time("B&B time: ");
+}
+
+// Every instance has at most 20 items with weights and prices up to 60, a fifth of them zero, so the DP stays cheap
+// and the corner cases of the ratio order come up often.
+std::size_t ProjectTester::check_solvers(std::size_t num_instances, std::size_t seed) {
+    std::mt19937_64 eng{seed};
+    std::uniform_int_distribution<std::size_t> value_dist(0, 60);
+    std::bernoulli_distribution zero_dist(0.2);
+    std::size_t failures = 0;
+    for (std::size_t instance = 0; instance < num_instances; ++instance) {
+        const std::size_t num_genes = std::uniform_int_distribution<std::size_t>(1, 20)(eng);
+        std::vector<config> configs(num_genes);
+        std::size_t total_weight = 0;
+        for (auto& [weight, price] : configs) {
+            weight = zero_dist(eng) ? 0 : value_dist(eng);
+            price = zero_dist(eng) ? 0 : value_dist(eng);
+            total_weight += weight;
+        }
+        const std::size_t capacity = std::uniform_int_distribution<std::size_t>(0, total_weight)(eng);
+        const std::size_t max_items = std::bernoulli_distribution(0.5)(eng)
+                                      ? std::uniform_int_distribution<std::size_t>(1, num_genes)(eng) : num_genes;
+        Knapsack knapsack(num_genes, capacity, max_items);
+        for (const auto& [weight, price] : configs) {
+            knapsack.add_config(weight, price);
+        }
+
+        dp.set_cf(&knapsack);
+        dp.solve();
+        const std::size_t optimum = dp.get_best_cost();
+        const auto fail = [&](const char* what, std::size_t cost) {
+            std::cout << "Instance " << instance << ": " << what << ' ' << cost << " against the optimum " << optimum
+                      << " with capacity " << capacity << " and item limit " << max_items << " for\n" << knapsack;
+            ++failures;
+        };
+
+        // The order is checked against its definition rather than Knapsack::better_ratio: weightless items with a
+        // price, then non-increasing ratios, then the (0, 0) items. The small values cannot overflow.
+        const auto order = knapsack.ratio_order();
+        const auto rank = [&configs](std::size_t gene) {
+            return configs[gene].first != 0 ? 1 : configs[gene].second != 0 ? 0 : 2;
+        };
+        for (std::size_t pos = 1; pos < order.size(); ++pos) {
+            const auto i = order[pos - 1];
+            const auto j = order[pos];
+            if (rank(i) > rank(j) || (rank(i) == 1 && rank(j) == 1 &&
+                    configs[i].second * configs[j].first < configs[j].second * configs[i].first)) {
+                fail("ratio order inverted at position", pos);
+            }
+        }
+        // greedy <= optimum <= LP bound
+        const auto& [greedy_cost, greedy_chromosome] = knapsack.greedy_solve(order);
+        if (greedy_cost > optimum || knapsack.eval(greedy_chromosome) != greedy_cost) {
+            fail("greedy cost", greedy_cost);
+        }
+        if (const auto bound = knapsack.lp_bound(order); bound < optimum) {
+            fail("LP bound", bound);
+        }
+
+        // The exact solvers must agree with the DP and their chromosomes must attain the optimum
+        if (knapsack.eval(dp.get_best_chromosome().view()) != optimum) {
+            fail("DP chromosome cost", knapsack.eval(dp.get_best_chromosome().view()));
+        }
+        bb.set_cf(&knapsack);
+        bb.set_num_threads(0);
+        bb.solve();
+        if (!bb.is_optimal() || bb.get_best_cost() != optimum || knapsack.eval(bb.get_best_chromosome().view()) != optimum) {
+            fail("branch and bound cost", bb.get_best_cost());
+        }
+        for (const auto mode : {BruteForce::Mode::Batch, BruteForce::Mode::GrayCode}) {
+            bf.set_cf(&knapsack);
+            bf.set_mode(mode);
+            bf.set_num_threads(0);
+            bf.solve();
+            if (bf.get_best_cost() != optimum || knapsack.eval(bf.get_best_chromosome().view()) != optimum) {
+                fail(mode == BruteForce::Mode::Batch ? "brute force cost" : "Gray code brute force cost", bf.get_best_cost());
+            }
+        }
+    }
+    std::cout << "Solver check: " << failures << " disagreements on " << num_instances << " instances.\n";
+    return failures;
+}
+
 void ProjectTester::greedy_solve(const Knapsack &knapsack) {
     Timer timer;
     const auto& [best_cost, best_chromosome] = knapsack.greedy_solve();
     std::cout << "Greedy best cost: " << best_cost << '\n';
+    std::cout << "Greedy upper bound: " << knapsack.lp_bound() << '\n';
     std::cout << "Greedy best chromosome: ";
     for (const auto& gene : best_chromosome) {
         std::cout << ((gene == BinaryCostFunction::Gene::Out) ? "Out " : "In ");
@@ -115,6 +239,9 @@ void ProjectTester::greedy_solve(const Knapsack &knapsack) {
 
 void ProjectTester::solve_(std::size_t num_gens, const std::optional<const std::string>& filename, const BinaryCostFunction* cf) {
     ga.set_cf(cf);
+    if (seed_) {
+        ga.set_seed(*seed_);
+    }
     ga.set_parameters(pop_size_, num_elite_, t_size_, mutation_rate_);
     Timer timer;
     ga.new_population(num_gens); // evolve the population
@@ -125,7 +252,11 @@ void ProjectTester::solve_(std::size_t num_gens, const std::optional<const std::
     std::cout << '\n';
     timer.time("GA time: ");
     if (filename) {
-        ga.export_results(*filename);
+        auto& sink = sink_();
+        const auto& best_costs = ga.get_best_costs();
+        sink.open(*filename, ResultsHeader::make(pop_size_, num_elite_, t_size_, mutation_rate_, cf->num_vars(), num_gens, 1));
+        sink.write_run(0, ga.get_solution_generation()+1, best_costs.data(), best_costs.size());
+        sink.close();
     }
 }
 
@@ -4,6 +4,10 @@
 #include "GA.h"
 #include "Knapsack.h"
 #include "BruteForce.h"
+#include "DPSolver.h"
+#include "BranchAndBound.h"
+#include "BatchRunner.h"
+#include "ResultsSink.h"
 
 #include <string>
 #include <optional>
@@ -12,6 +16,9 @@ class ProjectTester {
 public:
     using outfile = const std::optional<const std::string>&;;
 
+    // Backend used for results files
+    enum class ResultsFormat { Binary, Csv };
+
     // Constructor creates the cost functions/knapsacks from the project handout
     ProjectTester();
 
@@ -22,15 +29,25 @@ public:
     // Sets the ga parameters. These can be switched to test different combinations.
     void set_ga_parameters(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate) noexcept;
 
+    // Selects the format results files are written in - binary (read back with ResultsReader) by default
+    void set_results_format(ResultsFormat format) noexcept { results_format_ = format; }
+
+    // Seeds the GA runs deterministically - random (the default) when not given
+    void set_seed(std::optional<std::size_t> seed) noexcept { seed_ = seed; }
+
+    // Number of runs solve_all evolves concurrently - 0 (the default) uses one per hardware thread
+    void set_num_workers(std::size_t num_workers) { batch.set_num_workers(num_workers); }
+
     // Prepares (creates/clears) a file to write the GA results to.
     static void create_outfile(const std::string& filename);
 
     // Solves all the project knapsacks. If a filename is specified, results will be written to 5 different files
-    // with the knapsack number prepended to the input filename to avoid messing with extensions
+    // with the knapsack number prepended to the input filename to avoid messing with extensions. The num_runs runs
+    // of every knapsack are then evolved concurrently on the batch runner.
     void solve_all(std::size_t num_gens, std::size_t num_runs, outfile filename = std::nullopt);
 
     // This sucks - can be used to solve each cost function individually - specifying a filename will write the results
-    // to file. The results are the number of generation it takes to find the best cost solution followed
+    // to file as a single run. The results are the number of generation it takes to find the best cost solution followed
     // by the best cost solution in each generation (num_gens + 1) entries.
     void solve_cf1(std::size_t num_gens, outfile filename = std::nullopt) {return solve_(num_gens, filename, &cf1); }
     void solve_cf2(std::size_t num_gens, outfile filename = std::nullopt) {return solve_(num_gens, filename, &cf2); }
@@ -49,6 +66,17 @@ public:
     // Solves the input cf by brute force
     void bf_solve(const BinaryCostFunction* cf);
 
+    // Solves the input knapsack exactly by dynamic programming - usable far beyond brute force for moderate capacities
+    void dp_solve(const Knapsack& knapsack);
+
+    // Solves the input knapsack exactly by branch and bound, starting from the given incumbent (e.g. the GA's best
+    // solution) when one is supplied
+    void bb_solve(const Knapsack& knapsack, const std::optional<BinaryCostFunction::Chromosome>& incumbent = std::nullopt);
+
+    // Cross-checks the knapsack solvers against DPSolver on num_instances small random knapsacks that include items
+    // without weight and/or price and binding item limits. Prints every disagreement and returns their number.
+    std::size_t check_solvers(std::size_t num_instances, std::size_t seed);
+
     // This also sucks.
     void greedy_solve_cf1() {return greedy_solve(cf1); }
     void greedy_solve_cf2() {return greedy_solve(cf2); }
@@ -74,12 +102,22 @@ private:
 
     GA ga;
     BruteForce bf;
+    DPSolver dp;
+    BranchAndBound bb;
+    BatchRunner batch;
+    BinaryResultsSink binary_sink;
+    CsvResultsSink csv_sink;
 
     std::size_t pop_size_ = 0;
     std::size_t num_elite_ = 0;
     std::size_t t_size_ = 0;
     double mutation_rate_ = 0.;
+    std::optional<std::size_t> seed_;
+    ResultsFormat results_format_ = ResultsFormat::Binary;
 
+    [[nodiscard]] ResultsSink& sink_() noexcept {
+        return (results_format_ == ResultsFormat::Binary) ? static_cast<ResultsSink&>(binary_sink) : csv_sink;
+    }
     void solve_(std::size_t num_gens, outfile filename, const BinaryCostFunction* cf);
 };
 
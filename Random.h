@@ -0,0 +1,89 @@
+#ifndef PROJECT_RANDOM_H
+#define PROJECT_RANDOM_H
+
+#include <array>    // Generator state
+#include <cstdint>
+#include <limits>
+#include <random>   // std::uniform_int_distribution fallback
+
+// xoshiro256** (Blackman & Vigna): a 64-bit generator with 256 bits of state that is several times faster than
+// std::mt19937 and passes BigCrush. Satisfies UniformRandomBitGenerator, so it works with the standard
+// distributions. The state is filled from the seed with splitmix64, which is safe for small or correlated seeds.
+class Xoshiro256 {
+public:
+    using result_type = std::uint64_t;
+    using State = std::array<std::uint64_t, 4>;
+
+    explicit Xoshiro256(std::uint64_t seed = 0) noexcept { this->seed(seed); }
+
+    void seed(std::uint64_t seed) noexcept {
+        for (auto& word : state_) {
+            seed += 0x9E3779B97F4A7C15ull;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    result_type operator()() noexcept {
+        const std::uint64_t result = rotl_(state_[1] * 5, 7) * 9;
+        const std::uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl_(state_[3], 45);
+        return result;
+    }
+
+    // The full generator state, e.g. for checkpoints. A generator given the state of another continues its sequence.
+    [[nodiscard]] State state() const noexcept { return {state_[0], state_[1], state_[2], state_[3]}; }
+    void set_state(const State& state) noexcept {
+        for (std::size_t word = 0; word < state.size(); ++word) {
+            state_[word] = state[word];
+        }
+    }
+
+    static constexpr result_type min() noexcept { return 0; }
+    static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+    friend bool operator==(const Xoshiro256& lhs, const Xoshiro256& rhs) noexcept {
+        return lhs.state_[0] == rhs.state_[0] && lhs.state_[1] == rhs.state_[1] &&
+               lhs.state_[2] == rhs.state_[2] && lhs.state_[3] == rhs.state_[3];
+    }
+    friend bool operator!=(const Xoshiro256& lhs, const Xoshiro256& rhs) noexcept { return !(lhs == rhs); }
+private:
+    std::uint64_t state_[4] = {};
+
+    static constexpr std::uint64_t rotl_(std::uint64_t x, int k) noexcept { return (x << k) | (x >> (64 - k)); }
+};
+
+namespace rng {
+    // Unbiased random integer in [0, range) by Lemire's multiply-shift method: one 64x64 -> 128 bit multiply per
+    // draw and a (rarely taken) rejection step in place of a division. range must not be zero.
+    inline std::uint64_t bounded(Xoshiro256& eng, std::uint64_t range) noexcept {
+#ifdef __SIZEOF_INT128__
+        using Wide = unsigned __int128;
+        Wide product = static_cast<Wide>(eng()) * range;
+        auto low = static_cast<std::uint64_t>(product);
+        if (low < range) {
+            const std::uint64_t threshold = (0 - range) % range;
+            while (low < threshold) {
+                product = static_cast<Wide>(eng()) * range;
+                low = static_cast<std::uint64_t>(product);
+            }
+        }
+        return static_cast<std::uint64_t>(product >> 64);
+#else
+        return std::uniform_int_distribution<std::uint64_t>{0, range - 1}(eng);
+#endif
+    }
+
+    // Uniform double in [0, 1) from the top 53 bits of a draw
+    inline double canonical(Xoshiro256& eng) noexcept {
+        return static_cast<double>(eng() >> 11) * 0x1.0p-53;
+    }
+}
+#endif //PROJECT_RANDOM_H
@@ -0,0 +1,153 @@
+#include <algorithm>    // std::stable_sort, std::fill_n
+#include <limits>       // Utility of weightless items
+#include <numeric>      // std::iota
+
+#include "Repair.h"
+#include "Knapsack.h"
+#include "MultiKnapsack.h"
+
+// Removes genes from one end until the chromosome is feasible and then adds back as many genes as possible from the
+// other end, stopping at the first gene that does not fit.
+std::size_t TrimRepair::repair(const BinaryCostFunction& cf, PackedRef chromosome, Totals& totals) const noexcept {
+    const std::size_t num_genes = chromosome.num_genes();
+    if (cf.supports_totals()) {
+        // remove genes until the chromosome is feasible
+        for (std::size_t gene = 0; gene < num_genes && cf.eval_totals(totals) == 0; ++gene) {
+            if (chromosome.test(gene)) {
+                chromosome.reset(gene);
+                totals -= cf.gene_totals(gene);
+            }
+        }
+        // add genes from the other end until it is no longer feasible
+        for (std::size_t gene = num_genes; gene-- > 0;) {
+            if (!chromosome.test(gene)) {
+                const auto gene_totals = cf.gene_totals(gene);
+                if (cf.eval_totals(totals + gene_totals) == 0) {
+                    break;
+                }
+                chromosome.set(gene);
+                totals += gene_totals;
+            }
+        }
+        return cf.eval_totals(totals);
+    }
+    // remove genes until the chromosome is feasible
+    std::size_t gene = 0;
+    do {
+        chromosome.reset(gene);
+        while (gene < num_genes && !chromosome.test(gene)) {
+            ++gene;
+        }
+    } while (gene != num_genes && cf.eval(chromosome) == 0);
+    // add genes from the other end until it is no longer feasible
+    for (gene = num_genes; gene-- > 0;) {
+        if (!chromosome.test(gene)) {
+            chromosome.set(gene);
+            if (cf.eval(chromosome) == 0) {
+                chromosome.reset(gene); // Revert the last change that made the chromosome unfeasible
+                break;
+            }
+        }
+    }
+    return cf.eval(chromosome);
+}
+
+GreedyRatioRepair::GreedyRatioRepair(const Knapsack& knapsack) :
+    knapsack_(knapsack),
+    order_(knapsack.ratio_order())
+{}
+
+// Drop the worst ratio items until feasible, then refill with the best ratio items that fit. Calls the knapsack
+// directly with qualified calls (not through cf) so the totals updates are not virtual calls.
+std::size_t GreedyRatioRepair::repair(const BinaryCostFunction&, PackedRef chromosome, Totals& totals) const noexcept {
+    for (auto gene = order_.rbegin(); gene != order_.rend() && knapsack_.Knapsack::eval_totals(totals) == 0; ++gene) {
+        if (chromosome.test(*gene)) {
+            chromosome.reset(*gene);
+            totals -= knapsack_.Knapsack::gene_totals(*gene);
+        }
+    }
+    for (const auto gene : order_) {
+        if (!chromosome.test(gene)) {
+            if (const auto gene_totals = knapsack_.Knapsack::gene_totals(gene); knapsack_.Knapsack::eval_totals(totals + gene_totals) != 0) {
+                chromosome.set(gene);
+                totals += gene_totals;
+            }
+        }
+    }
+    return knapsack_.Knapsack::eval_totals(totals);
+}
+
+// The per-dimension orders are Knapsack::ratio_order's total key reversed, so items without price or weight in the
+// dimension are dropped first (losing nothing) and weightless items with a price last. The item limit's drop order is
+// the add order reversed.
+MultiKnapsackRepair::MultiKnapsackRepair(const MultiKnapsack& knapsack) :
+    knapsack_(knapsack),
+    drop_orders_(knapsack.num_dims() + 1),
+    add_order_(knapsack.num_vars())
+{
+    const std::size_t num_genes = knapsack.num_vars();
+    std::vector<double> utilities(num_genes, 0.);
+    for (std::size_t gene = 0; gene < num_genes; ++gene) {
+        double use = 0.;
+        for (std::size_t dim = 0; dim < knapsack.num_dims(); ++dim) {
+            use += static_cast<double>(knapsack.weight(gene, dim)) / std::max<std::size_t>(1, knapsack.capacity(dim));
+        }
+        utilities[gene] = use > 0. ? knapsack.price(gene) / use : std::numeric_limits<double>::infinity();
+    }
+    std::iota(std::begin(add_order_), std::end(add_order_), 0);
+    std::stable_sort(std::begin(add_order_), std::end(add_order_), [&utilities](std::size_t i, std::size_t j) {
+        return utilities[i] > utilities[j];
+    });
+    for (std::size_t dim = 0; dim < knapsack.num_dims(); ++dim) {
+        auto& order = drop_orders_[dim];
+        order.resize(num_genes);
+        std::iota(std::begin(order), std::end(order), 0);
+        std::stable_sort(std::begin(order), std::end(order), [&knapsack, dim](std::size_t i, std::size_t j) {
+            return Knapsack::better_ratio(knapsack.price(j), knapsack.weight(j, dim),
+                                          knapsack.price(i), knapsack.weight(i, dim));
+        });
+    }
+    drop_orders_.back().assign(add_order_.rbegin(), add_order_.rend());
+}
+
+// Items are only dropped while repairing, so each dimension's cursor only moves forward: O(num_dims * n) at worst.
+// A violated resource always has an In item with weight in it, so its cursor cannot run off the end.
+std::size_t MultiKnapsackRepair::repair(const BinaryCostFunction&, PackedRef chromosome, Totals&) const noexcept {
+    const std::size_t stride = knapsack_.stride();
+    alignas(32) std::size_t load[MultiKnapsack::max_dims];
+    std::fill_n(load, stride, 0);
+    std::size_t cost = knapsack_.add_load(chromosome, load);
+    std::size_t count = chromosome.view().count();
+    std::size_t cursors[MultiKnapsack::max_dims + 1] = {};
+    for (auto dim = knapsack_.violation(load, count); dim != MultiKnapsack::no_violation;
+         dim = knapsack_.violation(load, count)) {
+        const auto& order = drop_orders_[dim];
+        auto& cursor = cursors[dim];
+        while (!chromosome.test(order[cursor])) {
+            ++cursor;
+        }
+        const std::size_t gene = order[cursor];
+        chromosome.reset(gene);
+        const std::size_t* column = knapsack_.column(gene);
+        for (std::size_t d = 0; d < stride; ++d) {
+            load[d] -= column[d];
+        }
+        cost -= knapsack_.price(gene);
+        --count;
+    }
+    for (const auto gene : add_order_) {
+        if (count == knapsack_.max_items()) {
+            break;
+        }
+        if (!chromosome.test(gene) && knapsack_.fits(load, count, gene)) {
+            chromosome.set(gene);
+            const std::size_t* column = knapsack_.column(gene);
+            for (std::size_t d = 0; d < stride; ++d) {
+                load[d] += column[d];
+            }
+            cost += knapsack_.price(gene);
+            ++count;
+        }
+    }
+    return cost;
+}
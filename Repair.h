@@ -0,0 +1,64 @@
+#ifndef PROJECT_REPAIR_H
+#define PROJECT_REPAIR_H
+
+#include <vector>
+
+#include "BinaryCostFunction.h"
+
+class Knapsack;
+class MultiKnapsack;
+
+// Abstract base class for repair operators. The GA hands every unfeasible chromosome (cost of zero) to its repair
+// operator, which must turn it into a feasible one. Repair operators are shared by all GA threads, so repair must
+// not modify the operator itself.
+class RepairOperator {
+public:
+    using Totals = BinaryCostFunction::Totals;
+
+    // Destructor is virtual in the abstract base class
+    virtual ~RepairOperator() = default;
+
+    // Repairs the chromosome in place and returns its new cost. When the cost function supports running totals,
+    // totals holds the chromosome's totals on entry and must be kept in sync with every gene that is changed;
+    // otherwise it is unused.
+    virtual std::size_t repair(const BinaryCostFunction& cf, PackedRef chromosome, Totals& totals) const noexcept = 0;
+};
+
+// The GA's original repair: removes In genes from the front until the chromosome is feasible and then adds Out genes
+// from the back until the next one would make it unfeasible. Works with any cost function, but is position biased and,
+// without running totals, needs an eval call for every gene it changes.
+class TrimRepair : public RepairOperator {
+public:
+    std::size_t repair(const BinaryCostFunction& cf, PackedRef chromosome, Totals& totals) const noexcept override;
+};
+
+// Value/weight ratio driven repair for knapsacks. Drops In items in ascending price/weight order until the chromosome
+// is feasible, then refills Out items in descending order wherever they still fit. The ordering is computed once when
+// the operator is created and every step is an O(1) update of the running totals, so a repair is O(n) with no eval
+// calls. Must only be used with the knapsack it was created for.
+class GreedyRatioRepair : public RepairOperator {
+public:
+    explicit GreedyRatioRepair(const Knapsack& knapsack);
+
+    std::size_t repair(const BinaryCostFunction& cf, PackedRef chromosome, Totals& totals) const noexcept override;
+private:
+    const Knapsack& knapsack_;
+    std::vector<std::size_t> order_;    // Gene numbers sorted by descending price/weight ratio
+};
+
+// Repair for multi-dimensional knapsacks driven by the violated constraint. The load is computed once; then, while a
+// constraint is violated, the In item with the lowest price per unit of that resource is dropped (the lowest utility
+// item for the item limit), and finally Out items are added in descending utility order wherever they still fit.
+// Utility is the price over the item's weights as fractions of the capacities. Every step is a vectorized update of
+// the load, so a repair never calls eval. Must only be used with the knapsack it was created for.
+class MultiKnapsackRepair : public RepairOperator {
+public:
+    explicit MultiKnapsackRepair(const MultiKnapsack& knapsack);
+
+    std::size_t repair(const BinaryCostFunction& cf, PackedRef chromosome, Totals& totals) const noexcept override;
+private:
+    const MultiKnapsack& knapsack_;
+    std::vector<std::vector<std::size_t>> drop_orders_; // Per dimension, gene numbers by ascending price/weight ratio
+    std::vector<std::size_t> add_order_;                // Gene numbers by descending utility
+};
+#endif //PROJECT_REPAIR_H
@@ -0,0 +1,194 @@
+#include <algorithm>    // std::copy_n, std::fill_n, std::min
+#include <charconv>     // std::to_chars
+#include <cstring>      // std::memcpy, std::strlen
+#include <stdexcept>    // std::runtime_error
+
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // ftruncate, close
+
+#include "ResultsSink.h"
+
+using std::runtime_error; // If a results file cannot be created, mapped or read
+
+ResultsHeader ResultsHeader::make(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate,
+                                  std::size_t num_genes, std::size_t num_gens, std::size_t num_runs) noexcept {
+    const auto num_mutations = static_cast<std::size_t>(mutation_rate * pop_size * num_genes);
+    return {pop_size, num_elite, t_size, static_cast<double>(num_mutations)/pop_size/num_genes, num_gens, num_runs};
+}
+
+BinaryResultsSink::~BinaryResultsSink() {
+    close();
+}
+
+void BinaryResultsSink::open(const std::string& filename, const ResultsHeader& header) {
+    close();
+    num_runs_ = header.num_runs;
+    num_gens_ = header.num_gens;
+    size_ = results_file::file_size(num_runs_, num_gens_);
+    fd_ = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0 || ::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+        close();
+        throw runtime_error("Could not create the results file " + filename + '.');
+    }
+    mapping_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        close();
+        throw runtime_error("Could not map the results file " + filename + '.');
+    }
+    results_file::Header file_header{};
+    std::memcpy(file_header.magic, results_file::magic, sizeof(file_header.magic));
+    file_header.version = results_file::version;
+    file_header.header_size = sizeof(results_file::Header);
+    file_header.pop_size = header.pop_size;
+    file_header.num_elite = header.num_elite;
+    file_header.t_size = header.t_size;
+    file_header.mutation_rate = header.mutation_rate;
+    file_header.num_gens = header.num_gens;
+    file_header.num_runs = num_runs_;
+    std::memcpy(mapping_, &file_header, sizeof(file_header));
+}
+
+void BinaryResultsSink::write_run(std::size_t run_no, std::size_t solution_generation, const std::size_t* best_costs,
+                                  std::size_t num_costs) {
+    column_(0)[run_no] = solution_generation;
+    column_(1)[run_no] = num_costs;
+    auto* costs = column_(2) + run_no * num_gens_;
+    const std::size_t recorded = std::min(num_costs, num_gens_);
+    std::copy_n(best_costs, recorded, costs);
+    std::fill_n(costs + recorded, num_gens_ - recorded, recorded ? best_costs[recorded - 1] : 0);
+}
+
+void BinaryResultsSink::close() {
+    if (mapping_) {
+        ::munmap(mapping_, size_);
+        mapping_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+std::uint64_t* BinaryResultsSink::column_(std::size_t column) const noexcept {
+    return reinterpret_cast<std::uint64_t*>(static_cast<char*>(mapping_) + sizeof(results_file::Header)) + column * num_runs_;
+}
+
+void CsvResultsSink::open(const std::string& filename, const ResultsHeader& header) {
+    close();
+    outfile_.open(filename, std::ios::trunc | std::ios::binary);
+    if (!outfile_) {
+        throw runtime_error("Could not create the results file " + filename + '.');
+    }
+    buffer_.resize(buffer_size_);
+    num_gens_ = header.num_gens;
+    const std::string shape = "num_gens=" + std::to_string(header.num_gens) + ",num_runs=" + std::to_string(header.num_runs) + '\n';
+    const std::string parameters = leading_columns_.empty()
+        ? "# pop_size=" + std::to_string(header.pop_size) + ",num_elite=" + std::to_string(header.num_elite)
+          + ",t_size=" + std::to_string(header.t_size) + ",mutation_rate=" + std::to_string(header.mutation_rate) + ',' + shape
+        : "# " + shape + leading_columns_ + ',';
+    append_(parameters.data(), parameters.size());
+    append_("run,solution_generation", std::strlen("run,solution_generation"));
+    for (std::size_t generation = 0; generation < num_gens_; ++generation) {
+        append_(",gen_", 5);
+        append_(generation);
+    }
+    append_("\n", 1);
+}
+
+void CsvResultsSink::write_run(const std::string& leading_values, std::size_t run_no, std::size_t solution_generation,
+                               const std::size_t* best_costs, std::size_t num_costs) {
+    append_(leading_values.data(), leading_values.size());
+    append_(",", 1);
+    write_run(run_no, solution_generation, best_costs, num_costs);
+}
+
+void CsvResultsSink::write_run(std::size_t run_no, std::size_t solution_generation, const std::size_t* best_costs,
+                               std::size_t num_costs) {
+    append_(run_no);
+    append_(",", 1);
+    append_(solution_generation);
+    const std::size_t recorded = std::min(num_costs, num_gens_);
+    for (std::size_t generation = 0; generation < num_gens_; ++generation) {
+        append_(",", 1);
+        append_(generation < recorded ? best_costs[generation] : (recorded ? best_costs[recorded - 1] : 0));
+    }
+    append_("\n", 1);
+}
+
+void CsvResultsSink::close() {
+    if (outfile_.is_open()) {
+        flush_();
+        outfile_.close();
+    }
+}
+
+void CsvResultsSink::append_(const char* text, std::size_t length) {
+    if (used_ + length > buffer_.size()) {
+        flush_();
+    }
+    if (length > buffer_.size()) {
+        outfile_.write(text, static_cast<std::streamsize>(length));
+        return;
+    }
+    std::memcpy(buffer_.data() + used_, text, length);
+    used_ += length;
+}
+
+void CsvResultsSink::append_(std::size_t value) {
+    char digits[24];
+    const auto [end, error] = std::to_chars(std::begin(digits), std::end(digits), value);
+    append_(digits, static_cast<std::size_t>(end - digits));
+}
+
+void CsvResultsSink::flush_() {
+    outfile_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+    used_ = 0;
+}
+
+// Checks the magic, version and that the file is as long as its header says before handing out any pointers
+ResultsReader::ResultsReader(const std::string& filename) {
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    struct stat status{};
+    if (fd < 0 || ::fstat(fd, &status) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        throw runtime_error("Could not open the results file " + filename + '.');
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    void* mapping = (size_ >= sizeof(results_file::Header)) ? ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);    // The mapping stays valid
+    if (mapping == MAP_FAILED) {
+        throw runtime_error("Could not map the results file " + filename + '.');
+    }
+    mapping_ = mapping;
+    results_file::Header file_header;
+    std::memcpy(&file_header, mapping_, sizeof(file_header));
+    if (std::memcmp(file_header.magic, results_file::magic, sizeof(file_header.magic)) != 0 ||
+        file_header.version != results_file::version ||
+        results_file::file_size(file_header.num_runs, file_header.num_gens) != size_) {
+        ::munmap(const_cast<void*>(mapping_), size_);
+        throw runtime_error(filename + " is not a GA results file.");
+    }
+    num_runs_ = file_header.num_runs;
+    num_gens_ = file_header.num_gens;
+    ::madvise(const_cast<void*>(mapping_), size_, MADV_SEQUENTIAL);
+}
+
+ResultsReader::~ResultsReader() {
+    ::munmap(const_cast<void*>(mapping_), size_);
+}
+
+ResultsHeader ResultsReader::header() const noexcept {
+    results_file::Header file_header;
+    std::memcpy(&file_header, mapping_, sizeof(file_header));
+    return {file_header.pop_size, file_header.num_elite, file_header.t_size, file_header.mutation_rate,
+            file_header.num_gens, file_header.num_runs};
+}
+
+const std::uint64_t* ResultsReader::column_(std::size_t column) const noexcept {
+    return reinterpret_cast<const std::uint64_t*>(static_cast<const char*>(mapping_) + sizeof(results_file::Header)) + column * num_runs_;
+}
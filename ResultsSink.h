@@ -0,0 +1,150 @@
+#ifndef PROJECT_RESULTSSINK_H
+#define PROJECT_RESULTSSINK_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// GA parameters and shape of a results file: num_runs runs of num_gens per-generation best costs
+struct ResultsHeader {
+    std::size_t pop_size = 0;
+    std::size_t num_elite = 0;
+    std::size_t t_size = 0;
+    double mutation_rate = 0.;  // Effective rate - the requested rate rounded down to a whole number of mutations
+    std::size_t num_gens = 0;
+    std::size_t num_runs = 0;
+
+    // Builds a header, computing the effective mutation rate as GA::set_parameters rounds it
+    [[nodiscard]] static ResultsHeader make(std::size_t pop_size, std::size_t num_elite, std::size_t t_size, double mutation_rate,
+                                            std::size_t num_genes, std::size_t num_gens, std::size_t num_runs) noexcept;
+};
+
+// Destination for GA results. A sink is opened once with the header, receives every run (in any order) and is
+// closed once, so the backends can size and lay out the whole file up front.
+class ResultsSink {
+public:
+    virtual ~ResultsSink() = default;
+
+    // Creates (or truncates) the output for the runs described by the header. Will throw if it cannot be created.
+    virtual void open(const std::string& filename, const ResultsHeader& header) = 0;
+
+    // Records run run_no: the generation in which its best cost was first reached and its best cost per generation.
+    // Runs with more than header.num_gens costs are truncated; early stopped runs are padded with their last cost.
+    virtual void write_run(std::size_t run_no, std::size_t solution_generation, const std::size_t* best_costs,
+                           std::size_t num_costs) = 0;
+
+    // Flushes and closes the output
+    virtual void close() = 0;
+};
+
+// Binary results file layout, shared by BinaryResultsSink and ResultsReader. All fields are native endian 64-bit
+// values: the header, then three columns - solution generation per run, number of recorded costs per run, and a
+// num_runs x num_gens row-major matrix of best costs.
+namespace results_file {
+    constexpr char magic[8] = {'G', 'A', 'R', 'E', 'S', 'U', 'L', 'T'};
+    constexpr std::uint32_t version = 1;
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t header_size;
+        std::uint64_t pop_size;
+        std::uint64_t num_elite;
+        std::uint64_t t_size;
+        double mutation_rate;
+        std::uint64_t num_gens;
+        std::uint64_t num_runs;
+    };
+    static_assert(sizeof(Header) == 64, "The binary header is 64 bytes");
+
+    // Total file size for the given shape
+    [[nodiscard]] constexpr std::size_t file_size(std::size_t num_runs, std::size_t num_gens) noexcept {
+        return sizeof(Header) + sizeof(std::uint64_t) * num_runs * (2 + num_gens);
+    }
+}
+
+// Columnar binary backend. The file is sized in open and memory mapped, so writing a run is one copy into the
+// mapping and the operating system writes the pages back - no per-run open, seek or format calls.
+class BinaryResultsSink : public ResultsSink {
+public:
+    BinaryResultsSink() = default;
+    ~BinaryResultsSink() override;
+
+    void open(const std::string& filename, const ResultsHeader& header) override;
+    void write_run(std::size_t run_no, std::size_t solution_generation, const std::size_t* best_costs,
+                   std::size_t num_costs) override;
+    void close() override;
+
+    BinaryResultsSink &operator=(const BinaryResultsSink &) = delete;
+    BinaryResultsSink(const BinaryResultsSink &) = delete;
+private:
+    int fd_ = -1;
+    void* mapping_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t num_runs_ = 0;
+    std::size_t num_gens_ = 0;
+
+    [[nodiscard]] std::uint64_t* column_(std::size_t column) const noexcept;
+};
+
+// Text backend for compatibility with spreadsheet and script based analysis. One header comment line with the
+// parameters, one line of column names, then one row per run: run,solution_generation,gen_0,...,gen_{num_gens-1}.
+// Numbers are formatted with std::to_chars into a large buffer that is written out when full.
+// Files that mix runs of different parameters (see ParameterSweep) add leading columns that describe each row; the
+// header comment line then only holds num_gens and num_runs.
+class CsvResultsSink : public ResultsSink {
+public:
+    // Sets the comma separated names of the leading columns, written by open - empty (the default) for none
+    void set_leading_columns(std::string names) { leading_columns_ = std::move(names); }
+
+    void open(const std::string& filename, const ResultsHeader& header) override;
+    void write_run(std::size_t run_no, std::size_t solution_generation, const std::size_t* best_costs,
+                   std::size_t num_costs) override;
+    // Writes a run whose row starts with the comma separated values of the leading columns
+    void write_run(const std::string& leading_values, std::size_t run_no, std::size_t solution_generation,
+                   const std::size_t* best_costs, std::size_t num_costs);
+    void close() override;
+private:
+    static constexpr std::size_t buffer_size_ = std::size_t{1} << 20;
+
+    std::ofstream outfile_;
+    std::vector<char> buffer_;
+    std::size_t used_ = 0;
+    std::size_t num_gens_ = 0;
+    std::string leading_columns_;
+
+    void append_(const char* text, std::size_t length);
+    void append_(std::size_t value);
+    void flush_();
+};
+
+// Zero-copy reader for files written by BinaryResultsSink. The file is mapped read-only and runs are served as
+// pointers into the mapping, so analysis tools can stream over arbitrarily large result sets without parsing.
+class ResultsReader {
+public:
+    // Maps the file. Will throw if it cannot be opened or is not a results file.
+    explicit ResultsReader(const std::string& filename);
+    ~ResultsReader();
+
+    [[nodiscard]] ResultsHeader header() const noexcept;
+    [[nodiscard]] std::size_t num_runs() const noexcept { return num_runs_; }
+    [[nodiscard]] std::size_t num_gens() const noexcept { return num_gens_; }
+
+    [[nodiscard]] std::size_t solution_generation(std::size_t run_no) const noexcept { return column_(0)[run_no]; }
+    [[nodiscard]] std::size_t num_costs(std::size_t run_no) const noexcept { return column_(1)[run_no]; }
+    // The run's num_gens() best costs
+    [[nodiscard]] const std::uint64_t* costs(std::size_t run_no) const noexcept { return column_(2) + run_no * num_gens_; }
+
+    ResultsReader &operator=(const ResultsReader &) = delete;
+    ResultsReader(const ResultsReader &) = delete;
+private:
+    const void* mapping_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t num_runs_ = 0;
+    std::size_t num_gens_ = 0;
+
+    [[nodiscard]] const std::uint64_t* column_(std::size_t column) const noexcept;
+};
+#endif //PROJECT_RESULTSSINK_H
@@ -0,0 +1,73 @@
+#include <algorithm>    // std::upper_bound, std::min
+#include <cmath>        // std::sqrt
+#include <stdexcept>    // std::invalid_argument
+#include <utility>      // std::swap
+
+#include "Selection.h"
+
+using std::invalid_argument; // If the selection pressure is invalid
+
+void TournamentSelection::select(const SelectionView& view, Xoshiro256& eng, std::size_t* parents,
+                                 std::size_t num_parents) const noexcept {
+    for (std::size_t parent = 0; parent < num_parents; ++parent) {
+        auto champion = static_cast<std::size_t>(rng::bounded(eng, view.pop_size));
+        for (std::size_t participant = 1; participant < t_size_; ++participant) {
+            if (const auto challenger = static_cast<std::size_t>(rng::bounded(eng, view.pop_size));
+                view.costs[challenger] > view.costs[champion]) {
+                champion = challenger;
+            }
+        }
+        parents[parent] = champion;
+    }
+}
+
+RankSelection::RankSelection(double pressure) :
+    pressure_(pressure)
+{
+    if (pressure < 1. || pressure > 2.) {
+        throw invalid_argument("The rank selection pressure must be in [1, 2].");
+    }
+}
+
+// With x in [0, 1) the relative rank (0 is the best), the density is s - 2(s - 1)x and the CDF s x - (s - 1)x^2.
+// Solving CDF(x) = u for a uniform u gives the rank.
+void RankSelection::select(const SelectionView& view, Xoshiro256& eng, std::size_t* parents,
+                           std::size_t num_parents) const noexcept {
+    const double s = pressure_;
+    for (std::size_t parent = 0; parent < num_parents; ++parent) {
+        const double u = rng::canonical(eng);
+        const double x = (s == 1.) ? u : (s - std::sqrt(s * s - 4. * (s - 1.) * u)) / (2. * (s - 1.));
+        const auto rank = std::min(view.pop_size - 1, static_cast<std::size_t>(x * static_cast<double>(view.pop_size)));
+        parents[parent] = view.ranks[rank];
+    }
+}
+
+// Falls back to uniform selection when every cost is zero
+void SusSelection::select(const SelectionView& view, Xoshiro256& eng, std::size_t* parents,
+                          std::size_t num_parents) const noexcept {
+    if (num_parents == 0) {
+        return;
+    }
+    const std::size_t total = view.cumulative[view.pop_size - 1];
+    if (total == 0) {
+        for (std::size_t parent = 0; parent < num_parents; ++parent) {
+            parents[parent] = static_cast<std::size_t>(rng::bounded(eng, view.pop_size));
+        }
+        return;
+    }
+    const double spacing = static_cast<double>(total) / static_cast<double>(num_parents);
+    const double offset = rng::canonical(eng) * spacing;
+    const auto* first = view.cumulative;
+    const auto* last = view.cumulative + view.pop_size;
+    for (std::size_t parent = 0; parent < num_parents; ++parent) {
+        // First chromosome whose running sum passes the pointer. The pointers increase, so each search starts where
+        // the previous one ended.
+        const auto pointer = static_cast<std::size_t>(offset + spacing * static_cast<double>(parent));
+        first = std::upper_bound(first, last, pointer);
+        parents[parent] = std::min(view.pop_size - 1, static_cast<std::size_t>(first - view.cumulative));
+    }
+    // Fisher-Yates shuffle
+    for (std::size_t parent = num_parents - 1; parent > 0; --parent) {
+        std::swap(parents[parent], parents[rng::bounded(eng, parent + 1)]);
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef PROJECT_SELECTION_H
+#define PROJECT_SELECTION_H
+
+#include <cstddef>
+
+#include "Random.h"
+
+// What a selection policy sees of the population: the costs in chromosome order, the ranking (ranks[0] is the
+// number of the best chromosome) and, for policies that ask for it, the running sums of the costs.
+struct SelectionView {
+    const std::size_t* costs = nullptr;
+    const std::size_t* ranks = nullptr;
+    const std::size_t* cumulative = nullptr;    // cumulative[i] = costs[0] + ... + costs[i], or nullptr
+    std::size_t pop_size = 0;
+};
+
+// Parent selection interface used by the GA. select draws num_parents chromosome numbers at once, so policies can
+// generate their random numbers in bulk. Policies are stateless and shared between threads - select is const and
+// all randomness comes from the caller's engine.
+class SelectionPolicy {
+public:
+    virtual ~SelectionPolicy() = default;
+
+    // True if select reads view.cumulative. The GA only computes the running sums for policies that need them.
+    [[nodiscard]] virtual bool needs_cumulative() const noexcept { return false; }
+
+    // Writes num_parents selected chromosome numbers to parents
+    virtual void select(const SelectionView& view, Xoshiro256& eng, std::size_t* parents, std::size_t num_parents) const noexcept = 0;
+};
+
+// Tournament selection with replacement: the best of t_size uniformly drawn chromosomes, ties going to the earlier
+// draw. A higher tournament size increases the selection pressure; 1 is uniform selection. O(t_size) per parent.
+class TournamentSelection : public SelectionPolicy {
+public:
+    explicit TournamentSelection(std::size_t t_size = 2) noexcept : t_size_(t_size) {}
+
+    void select(const SelectionView& view, Xoshiro256& eng, std::size_t* parents, std::size_t num_parents) const noexcept override;
+private:
+    std::size_t t_size_;
+};
+
+// Linear ranking selection: the probability of being chosen falls linearly with rank, from pressure / P for the best
+// chromosome to (2 - pressure) / P for the worst. Ranks are drawn from the continuous linear distribution by
+// inverting its CDF, so a draw costs one random number and a square root whatever the population size. Insensitive
+// to the scale of the costs. Will throw if pressure is not in [1, 2].
+class RankSelection : public SelectionPolicy {
+public:
+    explicit RankSelection(double pressure = 2.);
+
+    void select(const SelectionView& view, Xoshiro256& eng, std::size_t* parents, std::size_t num_parents) const noexcept override;
+private:
+    double pressure_;
+};
+
+// Stochastic universal sampling: fitness proportional selection with num_parents equally spaced pointers over the
+// running cost sums and a single random offset, so the number of times a chromosome is chosen never strays more than
+// one from its expected value. The parents are shuffled afterwards so neighbouring draws are not paired up.
+class SusSelection : public SelectionPolicy {
+public:
+    [[nodiscard]] bool needs_cumulative() const noexcept override { return true; }
+
+    void select(const SelectionView& view, Xoshiro256& eng, std::size_t* parents, std::size_t num_parents) const noexcept override;
+};
+#endif //PROJECT_SELECTION_H
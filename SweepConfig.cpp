@@ -0,0 +1,218 @@
+#include <charconv>     // std::from_chars
+#include <fstream>
+#include <stdexcept>    // std::invalid_argument, std::runtime_error
+#include <string_view>
+
+#include "SweepConfig.h"
+
+using std::invalid_argument;    // If an argument, key or value is invalid
+using std::runtime_error;       // If the config file cannot be read
+
+namespace {
+    std::string_view trim(std::string_view text) noexcept {
+        const auto first = text.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+    }
+
+    // The trimmed comma separated items of a value list. Will throw if any item is empty.
+    std::vector<std::string_view> split(std::string_view values, const std::string& key) {
+        std::vector<std::string_view> items;
+        for (std::size_t first = 0;;) {
+            const auto comma = values.find(',', first);
+            const auto item = trim(values.substr(first, comma - first));
+            if (item.empty()) {
+                throw invalid_argument("Missing value for " + key + '.');
+            }
+            items.push_back(item);
+            if (comma == std::string_view::npos) {
+                return items;
+            }
+            first = comma + 1;
+        }
+    }
+
+    // Parses the whole item as a number
+    template <typename T>
+    T parse(std::string_view item, const std::string& key) {
+        T value{};
+        const auto [end, error] = std::from_chars(item.data(), item.data() + item.size(), value);
+        if (error != std::errc{} || end != item.data() + item.size()) {
+            throw invalid_argument("Invalid value '" + std::string(item) + "' for " + key + '.');
+        }
+        return value;
+    }
+
+    // Integer items, with first:last[:step] items expanded into their values
+    std::vector<std::size_t> parse_sizes(std::string_view values, const std::string& key) {
+        std::vector<std::size_t> sizes;
+        for (const auto item : split(values, key)) {
+            const auto colon = item.find(':');
+            if (colon == std::string_view::npos) {
+                sizes.push_back(parse<std::size_t>(item, key));
+                continue;
+            }
+            const auto second_colon = item.find(':', colon + 1);
+            const auto first = parse<std::size_t>(item.substr(0, colon), key);
+            const auto last = parse<std::size_t>(item.substr(colon + 1, second_colon - colon - 1), key);
+            const auto step = (second_colon == std::string_view::npos) ? 1 : parse<std::size_t>(item.substr(second_colon + 1), key);
+            if (step == 0 || first > last) {
+                throw invalid_argument("Invalid range '" + std::string(item) + "' for " + key + '.');
+            }
+            for (std::size_t value = first; value <= last && value >= first; value += step) {
+                sizes.push_back(value);
+            }
+        }
+        return sizes;
+    }
+
+    std::vector<double> parse_reals(std::string_view values, const std::string& key) {
+        std::vector<double> reals;
+        for (const auto item : split(values, key)) {
+            reals.push_back(parse<double>(item, key));
+        }
+        return reals;
+    }
+
+    // The one value of a key that does not take a list
+    std::string_view single(std::string_view values, const std::string& key) {
+        const auto items = split(values, key);
+        if (items.size() != 1) {
+            throw invalid_argument(key + " takes a single value.");
+        }
+        return items.front();
+    }
+}
+
+// The config file is read before any other argument so that the command line values replace its values. Instance
+// arguments are collected like the settings and added last, after any --instance values.
+SweepConfig SweepConfig::from_args(int argc, const char* const* argv) {
+    SweepConfig config;
+    std::vector<std::pair<std::string, std::string>> settings;
+    std::vector<std::string> instances;
+    for (int arg = 1; arg < argc; ++arg) {
+        const std::string_view text = argv[arg];
+        if (text == "--help" || text == "-h") {
+            config.help = true;
+            continue;
+        }
+        if (text == "--check") {
+            config.check = true;
+            continue;
+        }
+        if (text.substr(0, 2) != "--") {
+            instances.emplace_back(text);
+            continue;
+        }
+        std::string key(text.substr(2, text.find('=') - 2));
+        std::string values;
+        if (const auto equals = text.find('='); equals != std::string_view::npos) {
+            values = text.substr(equals + 1);
+        } else if (arg + 1 < argc) {
+            values = argv[++arg];
+        } else {
+            throw invalid_argument("Missing value for --" + key + '.');
+        }
+        if (key == "config") {
+            config.read_file(values);
+        } else {
+            settings.emplace_back(std::move(key), std::move(values));
+        }
+    }
+    if (!instances.empty()) {
+        config.instances.clear();
+    }
+    for (const auto& [key, values] : settings) {
+        config.set(key, values);
+    }
+    config.instances.insert(std::end(config.instances), std::begin(instances), std::end(instances));
+    return config;
+}
+
+void SweepConfig::read_file(const std::string& filename) {
+    std::ifstream infile{filename};
+    if (!infile) {
+        throw runtime_error("Could not open the config file " + filename + '.');
+    }
+    std::size_t line_no = 0;
+    for (std::string line; std::getline(infile, line);) {
+        ++line_no;
+        const auto content = trim(std::string_view(line).substr(0, line.find('#')));
+        if (content.empty()) {
+            continue;
+        }
+        const auto equals = content.find('=');
+        const std::string location = filename + ':' + std::to_string(line_no) + ": ";
+        if (equals == std::string_view::npos) {
+            throw invalid_argument(location + "Expected key = values.");
+        }
+        try {
+            set(std::string(trim(content.substr(0, equals))), std::string(content.substr(equals + 1)));
+        } catch (const invalid_argument& error) {
+            throw invalid_argument(location + error.what());
+        }
+    }
+}
+
+// Dashes and underscores are interchangeable in keys
+void SweepConfig::set(const std::string& key, const std::string& values) {
+    std::string name = key;
+    for (auto& c : name) {
+        c = (c == '-') ? '_' : c;
+    }
+    if (name == "instance" || name == "instances") {
+        instances.clear();
+        for (const auto item : split(values, name)) {
+            instances.emplace_back(item);
+        }
+    } else if (name == "pop_size") {
+        pop_sizes = parse_sizes(values, name);
+    } else if (name == "num_elite") {
+        num_elites = parse_sizes(values, name);
+    } else if (name == "t_size") {
+        t_sizes = parse_sizes(values, name);
+    } else if (name == "mutation_rate") {
+        mutation_rates = parse_reals(values, name);
+    } else if (name == "num_gens") {
+        num_gens = parse_sizes(values, name);
+    } else if (name == "runs") {
+        num_runs = parse<std::size_t>(single(values, name), name);
+    } else if (name == "seed") {
+        seed = parse<std::size_t>(single(values, name), name);
+    } else if (name == "workers") {
+        num_workers = parse<std::size_t>(single(values, name), name);
+    } else if (name == "output") {
+        output = single(values, name);
+    } else {
+        throw invalid_argument("Unknown parameter " + key + '.');
+    }
+}
+
+std::size_t SweepConfig::num_points() const noexcept {
+    return instances.size() * pop_sizes.size() * num_elites.size() * t_sizes.size() * mutation_rates.size() * num_gens.size();
+}
+
+std::ostream& SweepConfig::print_usage(std::ostream& os, const std::string& program) {
+    os << "Usage: " << program << " [--config FILE] [--KEY VALUES]... [INSTANCE]...\n"
+       << "       " << program << " --check [--seed SEED]\n"
+       << "Runs the GA over every combination of the given parameter values on every knapsack instance file (text\n"
+       << "or binary) and writes all the runs to one results file. Without instances the handout knapsacks are\n"
+       << "solved with the first value of each parameter.\n"
+       << "Keys (VALUES is a comma separated list; integers may be ranges FIRST:LAST[:STEP]):\n"
+       << "  instance        Instance files\n"
+       << "  pop_size        Population sizes (default 20)\n"
+       << "  num_elite       Elite chromosomes (default 1)\n"
+       << "  t_size          Tournament sizes (default 2)\n"
+       << "  mutation_rate   Mutation rates in [0, 1] (default 0.2)\n"
+       << "  num_gens        Generations per run (default 1000)\n"
+       << "  runs            Runs per parameter combination (default 1)\n"
+       << "  seed            Seed for reproducible runs (default random)\n"
+       << "  workers         Concurrent runs, 0 for one per hardware thread (default 0)\n"
+       << "  output          Results file (default sweep.csv, or best_costs for the handout knapsacks)\n"
+       << "--check compares the knapsack solvers on random small instances and fails if any of them disagree.\n"
+       << "A config file holds one \"KEY = VALUES\" line per parameter; '#' starts a comment. Command line values\n"
+       << "replace those of the config file.\n";
+    return os;
+}
@@ -0,0 +1,52 @@
+#ifndef PROJECT_SWEEPCONFIG_H
+#define PROJECT_SWEEPCONFIG_H
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Run-time configuration of the program: the instance files and a grid of GA parameters, read from a config file
+// and/or the command line so parameter sweeps need no recompilation (see ParameterSweep).
+//
+// Every parameter takes a comma separated list of values and the grid is their Cartesian product. Integer values
+// may also be inclusive ranges first:last or first:last:step. A config file holds one "key = values" line per
+// parameter; blank lines and everything after a '#' are ignored. For example:
+//     instance = data/large_1.txt, data/large_2.bin
+//     pop_size = 20:100:20
+//     mutation_rate = 0.01, 0.05, 0.2
+//     runs = 30
+// On the command line the same keys are given as --key values or --key=values, and any other argument is an
+// instance file. Command line values replace those of the config file - instance arguments and --instance values
+// together replace the config file's instances.
+struct SweepConfig {
+    std::vector<std::string> instances;          // Knapsack instance files, text or binary (see KnapsackLoader.h)
+    std::vector<std::size_t> pop_sizes{20};
+    std::vector<std::size_t> num_elites{1};
+    std::vector<std::size_t> t_sizes{2};
+    std::vector<double> mutation_rates{0.2};
+    std::vector<std::size_t> num_gens{1000};
+    std::size_t num_runs = 1;                    // Runs of every grid point
+    std::optional<std::size_t> seed;             // Seeds the runs deterministically - random when not given
+    std::size_t num_workers = 0;                 // Concurrent runs, 0 for one per hardware thread
+    std::string output;                          // Results file - empty for the default name
+    bool help = false;                           // --help was given
+    bool check = false;                          // --check was given - cross-check the solvers instead of running
+
+    // Builds the configuration from the command line, reading the config file named by --config first.
+    // Will throw if an argument or the config file is invalid.
+    [[nodiscard]] static SweepConfig from_args(int argc, const char* const* argv);
+
+    // Applies every "key = values" line of a config file. Will throw if it cannot be read or a line is invalid.
+    void read_file(const std::string& filename);
+
+    // Sets one parameter from its text form. Will throw if the key is unknown or a value is invalid.
+    void set(const std::string& key, const std::string& values);
+
+    // Number of grid points: instances times every combination of the GA parameters
+    [[nodiscard]] std::size_t num_points() const noexcept;
+
+    // Prints the command line and config file syntax
+    static std::ostream& print_usage(std::ostream& os, const std::string& program);
+};
+#endif //PROJECT_SWEEPCONFIG_H
@@ -0,0 +1,149 @@
+#ifndef PROJECT_TELEMETRY_H
+#define PROJECT_TELEMETRY_H
+
+#include <algorithm>  // std::min
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "BinaryCostFunction.h"
+
+// Generation telemetry for the GA. Compiled into the GA only when GA_TELEMETRY is defined (e.g. -DGA_TELEMETRY);
+// without it none of the timers, counters or buffers below exist in GA and the generation loop is unchanged.
+// Each generation (steady state step) produces one record. Records go into a fixed size ring buffer that is handed to
+// a TelemetryObserver in batches, so the loop itself never does I/O and never allocates.
+
+// What one generation (or steady state step) did. Times are nanoseconds. Selection and crossover are interleaved per
+// offspring chunk, so with several threads their times are summed over the chunks and can exceed the wall time.
+struct GenerationTelemetry {
+    std::size_t generation = 0;         // Number of the generation within its new_population call, from 1
+    std::size_t best_cost = 0;          // Best cost once the generation is done
+    std::uint64_t select_ns = 0;        // Parent selection, including the policy's preparation
+    std::uint64_t cross_ns = 0;         // Crossover and copying the elites
+    std::uint64_t mutate_ns = 0;
+    std::uint64_t eval_ns = 0;          // Cost calculation, excluding ranking
+    std::uint64_t repair_ns = 0;        // Repair, excluding ranking
+    std::uint64_t rank_ns = 0;
+    std::size_t num_evals = 0;          // Evaluations made through the cost function (eval, eval_batch per
+                                        // chromosome and eval_totals), including those made by repairs
+    std::size_t num_repaired = 0;       // Chromosomes repaired
+    std::size_t repair_evals = 0;       // Evaluations made by the repairs
+    double diversity = -1.;             // GA::get_diversity() of the new population, -1 when not measured
+};
+
+// Receives telemetry records. Called on the thread running new_population, with batches of records in generation
+// order, whenever the ring buffer is full and once at the end of every new_population call. The records are only
+// valid during the call.
+class TelemetryObserver {
+public:
+    virtual ~TelemetryObserver() = default;
+
+    virtual void on_telemetry(const GenerationTelemetry* records, std::size_t num_records) = 0;
+};
+
+// Fixed capacity buffer of the most recent records. With an observer the records are drained to it whenever the
+// buffer fills up; without one the oldest records are overwritten.
+class TelemetryRing {
+public:
+    static constexpr std::size_t default_capacity = 1024;
+
+    explicit TelemetryRing(std::size_t capacity = default_capacity) : records_(capacity ? capacity : 1) {}
+
+    void set_observer(TelemetryObserver* observer) noexcept { observer_ = observer; }
+
+    void push(const GenerationTelemetry& record) noexcept {
+        if (size_ == records_.size()) {
+            if (observer_) {
+                flush();
+            } else {
+                first_ = (first_ + 1) % records_.size();
+                --size_;
+            }
+        }
+        records_[(first_ + size_++) % records_.size()] = record;
+    }
+
+    // Hands the buffered records to the observer and empties the buffer. Does nothing without an observer.
+    void flush() noexcept {
+        if (!observer_) {
+            return;
+        }
+        if (size_ != 0) {
+            const std::size_t head = std::min(size_, records_.size() - first_);
+            observer_->on_telemetry(records_.data() + first_, head);
+            if (head != size_) {
+                observer_->on_telemetry(records_.data(), size_ - head);
+            }
+        }
+        first_ = size_ = 0;
+    }
+
+    // Buffered records, oldest first
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] const GenerationTelemetry& operator[](std::size_t index) const noexcept {
+        return records_[(first_ + index) % records_.size()];
+    }
+private:
+    std::vector<GenerationTelemetry> records_;
+    std::size_t first_ = 0;     // Slot of the oldest record
+    std::size_t size_ = 0;
+    TelemetryObserver* observer_ = nullptr;
+};
+
+// Forwards every call to a cost function and counts the evaluations. The GA evaluates through one of these when
+// telemetry is compiled in, so evaluations made by repair operators are counted too.
+class CountingCostFunction : public BinaryCostFunction {
+public:
+    explicit CountingCostFunction(const BinaryCostFunction& cf) noexcept : BinaryCostFunction(cf.num_vars()), cf_(cf) {}
+
+    [[nodiscard]] std::size_t eval(const Chromosome& chromosome) const override { count_(1); return cf_.eval(chromosome); }
+    [[nodiscard]] std::size_t eval(PackedView chromosome) const override { count_(1); return cf_.eval(chromosome); }
+    void eval_batch(const packed::Word* genes, std::size_t words_per_chromosome, std::size_t num_chromosomes,
+                    std::size_t* costs) const override {
+        count_(num_chromosomes);
+        cf_.eval_batch(genes, words_per_chromosome, num_chromosomes, costs);
+    }
+
+    [[nodiscard]] bool supports_totals() const noexcept override { return cf_.supports_totals(); }
+    [[nodiscard]] Totals totals(PackedView chromosome, std::size_t first_gene, std::size_t last_gene) const noexcept override {
+        return cf_.totals(chromosome, first_gene, last_gene);
+    }
+    [[nodiscard]] Totals gene_totals(std::size_t gene) const noexcept override { return cf_.gene_totals(gene); }
+    [[nodiscard]] std::size_t eval_totals(const Totals& totals) const noexcept override { count_(1); return cf_.eval_totals(totals); }
+    [[nodiscard]] bool feasible(const Totals& totals) const noexcept override { return cf_.feasible(totals); }
+
+    // Evaluations counted so far
+    [[nodiscard]] std::size_t num_evals() const noexcept { return num_evals_.load(std::memory_order_relaxed); }
+private:
+    const BinaryCostFunction& cf_;
+    mutable std::atomic<std::size_t> num_evals_{0};
+
+    void count_(std::size_t num) const noexcept { num_evals_.fetch_add(num, std::memory_order_relaxed); }
+};
+
+// Adds the nanoseconds from its construction to its destruction to a telemetry field
+class PhaseTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit PhaseTimer(std::uint64_t& field) noexcept : field_(field), start_(Clock::now()) {}
+    ~PhaseTimer() {
+        field_ += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_).count());
+    }
+
+    PhaseTimer &operator=(const PhaseTimer &) = delete;
+    PhaseTimer(const PhaseTimer &) = delete;
+private:
+    std::uint64_t& field_;
+    Clock::time_point start_;
+};
+
+// Times the rest of the enclosing scope into the given field of the GA's current telemetry record
+#ifdef GA_TELEMETRY
+#define GA_TIME_PHASE(field) const PhaseTimer phase_timer_(telemetry_record_.field)
+#else
+#define GA_TIME_PHASE(field) static_cast<void>(0)
+#endif
+
+#endif //PROJECT_TELEMETRY_H
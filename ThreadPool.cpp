@@ -0,0 +1,69 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(std::size_t num_threads) {
+    for (std::size_t thread_no = 1; thread_no < num_threads; ++thread_no) {
+        workers_.emplace_back([this]() { worker_loop_(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+// Publishes the batch, works on it from the calling thread and waits until every worker has left it.
+void ThreadPool::run_(std::size_t num_tasks, Task task, void* context) {
+    if (workers_.empty() || num_tasks <= 1) {
+        for (std::size_t task_no = 0; task_no < num_tasks; ++task_no) {
+            task(context, task_no);
+        }
+        return;
+    }
+    {
+        std::lock_guard lock(mutex_);
+        task_ = task;
+        context_ = context;
+        num_tasks_ = num_tasks;
+        next_task_.store(0, std::memory_order_relaxed);
+        active_ = workers_.size();
+        ++batch_;
+    }
+    start_cv_.notify_all();
+    drain_();
+    std::unique_lock lock(mutex_);
+    done_cv_.wait(lock, [this]() { return active_ == 0; });
+}
+
+// Claims and runs tasks of the current batch until none are left
+void ThreadPool::drain_() noexcept {
+    for (auto task_no = next_task_.fetch_add(1); task_no < num_tasks_; task_no = next_task_.fetch_add(1)) {
+        task_(context_, task_no);
+    }
+}
+
+void ThreadPool::worker_loop_() {
+    std::size_t seen_batch = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            start_cv_.wait(lock, [&]() { return stop_ || batch_ != seen_batch; });
+            if (stop_) {
+                return;
+            }
+            seen_batch = batch_;
+        }
+        drain_();
+        {
+            std::lock_guard lock(mutex_);
+            if (--active_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+}
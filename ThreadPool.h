@@ -0,0 +1,53 @@
+#ifndef PROJECT_THREADPOOL_H
+#define PROJECT_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>  // std::remove_reference_t
+#include <vector>
+
+// Minimal fork-join pool used by the GA to spread work over a fixed set of threads. parallel_for blocks the caller,
+// which also works on the tasks, until every task has finished. Dispatch stores a pointer to the callable rather
+// than a std::function so running a batch of tasks never allocates.
+class ThreadPool {
+public:
+    // Creates a pool where num_threads threads (including the calling thread) work on each batch.
+    explicit ThreadPool(std::size_t num_threads);
+    ~ThreadPool();
+
+    // Calls fn(task) for every task in [0, num_tasks) across the pool and waits for all of them to complete.
+    // fn must be safe to call concurrently and must not throw.
+    template <typename Fn>
+    void parallel_for(std::size_t num_tasks, Fn&& fn) {
+        run_(num_tasks, [](void* context, std::size_t task) { (*static_cast<std::remove_reference_t<Fn>*>(context))(task); },
+             static_cast<void*>(&fn));
+    }
+
+    // Number of threads working on each batch (workers + caller)
+    [[nodiscard]] std::size_t size() const noexcept { return workers_.size() + 1; }
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ThreadPool(const ThreadPool &) = delete;
+private:
+    using Task = void (*)(void*, std::size_t);
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;  // Signals workers that a new batch is available (or that the pool is stopping)
+    std::condition_variable done_cv_;   // Signals the caller that the last worker has left the batch
+
+    Task task_ = nullptr;
+    void* context_ = nullptr;
+    std::size_t num_tasks_ = 0;
+    std::atomic<std::size_t> next_task_{0}; // Next task index to hand out
+    std::size_t batch_ = 0;                 // Incremented for every batch so workers can tell batches apart
+    std::size_t active_ = 0;                // Workers still inside the current batch
+    bool stop_ = false;
+
+    void run_(std::size_t num_tasks, Task task, void* context);
+    void drain_() noexcept;
+    void worker_loop_();
+};
+#endif //PROJECT_THREADPOOL_H
@@ -0,0 +1,73 @@
+#include <algorithm>    // std::copy_n
+#include <stdexcept>    // std::invalid_argument
+
+#include "WarmStart.h"
+
+using std::invalid_argument;    // If a chromosome does not have num_genes genes
+
+WarmStart::WarmStart(std::size_t num_genes) noexcept :
+    num_genes_(num_genes)
+{}
+
+void WarmStart::add(PackedView chromosome) {
+    if (chromosome.num_genes() != num_genes_) {
+        throw invalid_argument("The warm start chromosome has the wrong number of genes.");
+    }
+    const auto seed = append_();
+    std::copy_n(chromosome.words(), seed.num_words(), seed.data());
+}
+
+void WarmStart::add(const Chromosome& chromosome) {
+    add(BinaryCostFunction::pack(chromosome).view());
+}
+
+void WarmStart::add(const Word* genes, std::size_t num_chromosomes) {
+    const std::size_t stride = packed::num_words(num_genes_);
+    for (std::size_t chromosome_no = 0; chromosome_no < num_chromosomes; ++chromosome_no) {
+        add(PackedView{genes + chromosome_no * stride, num_genes_});
+    }
+}
+
+void WarmStart::add_greedy(const Knapsack& knapsack) {
+    check_(knapsack);
+    add(knapsack.greedy_solve().second);
+}
+
+void WarmStart::add_greedy(const Knapsack& knapsack, const std::vector<std::size_t>& order) {
+    check_(knapsack);
+    add(knapsack.greedy_solve(order).second);
+}
+
+void WarmStart::add_lp_rounded(const Knapsack& knapsack) {
+    add_lp_rounded(knapsack, knapsack.ratio_order());
+}
+
+// The LP optimum takes whole items in ratio order and a fraction of the first one that does not fit - rounding
+// down drops that item and everything after it
+void WarmStart::add_lp_rounded(const Knapsack& knapsack, const std::vector<std::size_t>& order) {
+    check_(knapsack);
+    const auto* weights = knapsack.weights();
+    const auto seed = append_();
+    std::size_t weight = 0;
+    std::size_t num_items = 0;
+    for (const auto gene : order) {
+        if (num_items == knapsack.max_items() || weight + weights[gene] > knapsack.max_weight()) {
+            break;
+        }
+        seed.set(gene);
+        weight += weights[gene];
+        ++num_items;
+    }
+}
+
+PackedRef WarmStart::append_() {
+    const std::size_t stride = packed::num_words(num_genes_);
+    genes_.resize(genes_.size() + stride);
+    return {genes_.data() + genes_.size() - stride, num_genes_};
+}
+
+void WarmStart::check_(const Knapsack& knapsack) const {
+    if (knapsack.num_vars() != num_genes_) {
+        throw invalid_argument("The knapsack does not have num_genes configurations.");
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef PROJECT_WARMSTART_H
+#define PROJECT_WARMSTART_H
+
+#include <vector>
+
+#include "BinaryCostFunction.h"
+#include "Knapsack.h"
+
+// Collects the packed chromosomes a GA's initial population is seeded with (see GA::set_warm_start): heuristic
+// solutions such as the greedy or LP-rounded knapsack, or the elites of a previous run (GA::export_elites). The
+// seeded chromosomes take the first population slots and the rest are random; unfeasible ones are repaired as usual.
+class WarmStart {
+public:
+    using Word = packed::Word;
+    using Chromosome = BinaryCostFunction::Chromosome;
+
+    // Creates an empty set of seeds for chromosomes of num_genes genes
+    explicit WarmStart(std::size_t num_genes) noexcept;
+
+    // Adds one chromosome. Will throw if its number of genes is not num_genes().
+    void add(PackedView chromosome);
+    void add(const Chromosome& chromosome);
+
+    // Adds num_chromosomes contiguous packed chromosomes, as written by GA::export_elites
+    void add(const Word* genes, std::size_t num_chromosomes);
+
+    // Adds the knapsack's greedy solution (see Knapsack::greedy_solve). O(n log n), or O(n) given its ratio_order().
+    void add_greedy(const Knapsack& knapsack);
+    void add_greedy(const Knapsack& knapsack, const std::vector<std::size_t>& order);
+
+    // Adds the LP relaxation's solution rounded down: the items in ratio order up to, but not including, the first
+    // one that does not fit or would exceed the item limit. Never better than the greedy solution, but a different
+    // starting point.
+    void add_lp_rounded(const Knapsack& knapsack);
+    void add_lp_rounded(const Knapsack& knapsack, const std::vector<std::size_t>& order);
+
+    void clear() noexcept { genes_.clear(); }
+
+    // The seeds as contiguous packed chromosomes, num_words(num_genes()) words each
+    [[nodiscard]] const Word* genes() const noexcept { return genes_.data(); }
+    [[nodiscard]] std::size_t size() const noexcept { return genes_.size() / packed::num_words(num_genes_); }
+    [[nodiscard]] bool empty() const noexcept { return genes_.empty(); }
+    [[nodiscard]] std::size_t num_genes() const noexcept { return num_genes_; }
+private:
+    // Appends an empty chromosome and returns it
+    PackedRef append_();
+
+    // Will throw if the knapsack's chromosomes are not num_genes_ genes long
+    void check_(const Knapsack& knapsack) const;
+
+    std::size_t num_genes_;
+    std::vector<Word> genes_;
+};
+#endif //PROJECT_WARMSTART_H
@@ -0,0 +1,71 @@
+// Microbenchmark for the knapsack evaluation kernels. Compares Knapsack::eval on the unpacked std::vector<Gene>
+// chromosome the GA originally used against eval on the packed chromosome (the two checksums match), then times the
+// raw packed kernel for every instruction set the CPU supports.
+// Build from the repository root, e.g.:
+//     g++ -std=c++17 -O2 -DNDEBUG -I. bench/EvalKernelBench.cpp Knapsack.cpp EvalKernel.cpp -o eval_kernel_bench
+#include <iostream>
+#include <random>
+
+#include "EvalKernel.h"
+#include "Knapsack.h"
+#include "Timer.h"
+
+namespace {
+    constexpr std::size_t num_chromosomes = 64;
+
+    // Prints the throughput of one variant and the checksum of its results so the variants can be compared
+    template <typename Fn>
+    void run(const std::string& label, std::size_t num_genes, std::size_t repeats, Fn&& fn) {
+        std::size_t checksum = 0;
+        Timer timer;
+        for (std::size_t repeat = 0; repeat < repeats; ++repeat) {
+            for (std::size_t chromosome_no = 0; chromosome_no < num_chromosomes; ++chromosome_no) {
+                checksum += fn(chromosome_no);
+            }
+        }
+        const double seconds = timer.get_time_diff();
+        const double evals = static_cast<double>(repeats * num_chromosomes);
+        std::cout << "  " << label << ": " << evals / seconds << " evals/s, " << evals * num_genes / seconds
+                  << " genes/s (checksum " << checksum << ")\n";
+    }
+}
+
+int main() {
+    std::mt19937 eng{42};
+    for (std::size_t num_genes : {64, 1000, 10000, 100000}) {
+        Knapsack knapsack(num_genes, num_genes * 10, num_genes);
+        knapsack.random_configs();
+        std::vector<PackedChromosome> packed_population;
+        std::vector<BinaryCostFunction::Chromosome> unpacked_population;
+        for (std::size_t chromosome_no = 0; chromosome_no < num_chromosomes; ++chromosome_no) {
+            PackedChromosome chromosome(num_genes);
+            for (std::size_t gene = 0; gene < num_genes; ++gene) {
+                if (eng() & 1) {
+                    chromosome.set(gene);
+                }
+            }
+            unpacked_population.push_back(BinaryCostFunction::unpack(chromosome));
+            packed_population.push_back(std::move(chromosome));
+        }
+        const std::size_t repeats = std::max<std::size_t>(1, 20000000 / (num_genes * num_chromosomes));
+        std::cout << num_genes << " genes:\n";
+        run("Knapsack::eval(Chromosome)", num_genes, repeats, [&](std::size_t chromosome_no) {
+            return knapsack.eval(unpacked_population[chromosome_no]);
+        });
+        run("Knapsack::eval(PackedView)", num_genes, repeats, [&](std::size_t chromosome_no) {
+            return knapsack.eval(packed_population[chromosome_no].view());
+        });
+        for (auto isa : {eval_kernel::Isa::Scalar, eval_kernel::Isa::Avx2, eval_kernel::Isa::Avx512}) {
+            if (!eval_kernel::supported(isa)) {
+                continue;
+            }
+            run(std::string("packed ") + eval_kernel::name(isa), num_genes, repeats, [&](std::size_t chromosome_no) {
+                const auto& chromosome = packed_population[chromosome_no];
+                // Full words only - the kernel requires 64 configurations per word
+                const auto totals = eval_kernel::sum_words(isa, chromosome.data(), num_genes / packed::bits_per_word,
+                                                           knapsack.weights(), knapsack.prices());
+                return totals.weight + totals.value;
+            });
+        }
+    }
+}
@@ -0,0 +1,282 @@
+// Google Benchmark suite for the GA operators and the exact/heuristic solvers. Sweeps the chromosome size from 10 to
+// 1M genes (and the population size for the GA operators) and reports evals/s and genes/s counters. Building without
+// NDEBUG links in the allocation counter, and the generation benchmark then also reports allocs_per_gen (which should
+// be zero). Build from the repository root and write JSON for regression tracking, e.g.:
+//     g++ -std=c++17 -O2 -pthread -I. bench/GABench.cpp $(ls *.cpp | grep -v main.cpp) -lbenchmark -o ga_bench
+//     ./ga_bench --benchmark_format=json --benchmark_out=ga_bench.json
+#include <benchmark/benchmark.h>
+
+#include <algorithm>  // std::fill_n, std::generate
+#include <cstdint>
+#include <memory>
+#include <random>     // Multi-dimensional knapsack weights
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "BruteForce.h"
+#include "GA.h"
+#include "Knapsack.h"
+#include "MultiKnapsack.h"
+#include "Repair.h"
+
+// Runs the private GA operators of the default engine on their own. Each operator is used exactly as the generation loop uses it.
+struct GABenchAccess {
+    // Draws the parents of every child with the GA's selection policy - the selection half of produce_chunk_
+    static void select(DefaultGA& ga) {
+        ga.prepare_selection_();
+        const auto view = ga.selection_view_();
+        ga.selection_.select(view, ga.eng_, ga.parents_.data(), ga.parents_.size());
+        benchmark::DoNotOptimize(ga.parents_.data());
+    }
+    // Crosses neighbouring chromosomes into every slot of the next population
+    static void cross(DefaultGA& ga) {
+        for (std::size_t child_no = 0; child_no < ga.population_size_; ++child_no) {
+            ga.cross_(child_no, (child_no + 1) % ga.population_size_, child_no, ga.eng_);
+        }
+        benchmark::ClobberMemory();
+    }
+    static void mutate(DefaultGA& ga) { ga.mutate_(); }
+    // Evaluates the whole population - every chromosome is marked dirty first
+    static void calculate_costs(DefaultGA& ga) {
+        for (std::size_t chromosome_no = 0; chromosome_no < ga.population_size_; ++chromosome_no) {
+            ga.population_.mark_dirty(chromosome_no);
+        }
+        ga.calculate_costs_();
+    }
+    static void repair(DefaultGA& ga) { ga.repair_(); }
+    // Puts every gene of every chromosome In, so the whole population needs repairing
+    static void overfill(DefaultGA& ga) {
+        auto& population = ga.population_;
+        for (std::size_t chromosome_no = 0; chromosome_no < ga.population_size_; ++chromosome_no) {
+            auto chromosome = population[chromosome_no];
+            std::fill_n(chromosome.data(), chromosome.num_words(), ~packed::Word{0});
+            chromosome.trim();
+            population.totals(chromosome_no) = ga.cf_->totals(chromosome, 0, chromosome.num_genes());
+            population.cost(chromosome_no) = 0;
+        }
+    }
+    [[nodiscard]] static std::size_t population_size(const DefaultGA& ga) noexcept { return ga.population_size_; }
+};
+
+namespace {
+    constexpr double mutation_rate = 0.01;
+
+    // A random knapsack whose optimum holds about a third of the items
+    std::unique_ptr<Knapsack> make_knapsack(std::size_t num_genes) {
+        auto knapsack = std::make_unique<Knapsack>(num_genes, num_genes * 5, num_genes);
+        knapsack->random_configs();
+        return knapsack;
+    }
+
+    std::unique_ptr<DefaultGA> make_ga(const BinaryCostFunction& cf, std::size_t pop_size) {
+        auto ga = std::make_unique<DefaultGA>(42);
+        ga->set_cf(&cf);
+        ga->set_parameters(pop_size, 1, 2, mutation_rate);
+        return ga;
+    }
+
+    // The knapsack without its running totals, so the GA evaluates whole chromosomes through eval_batch
+    class FullEvalKnapsack : public BinaryCostFunction {
+    public:
+        explicit FullEvalKnapsack(const Knapsack& knapsack) : BinaryCostFunction(knapsack.num_vars()), knapsack_(knapsack) {}
+
+        [[nodiscard]] std::size_t eval(const Chromosome& chromosome) const override { return knapsack_.eval(chromosome); }
+        [[nodiscard]] std::size_t eval(PackedView chromosome) const override { return knapsack_.eval(chromosome); }
+        void eval_batch(const packed::Word* genes, std::size_t words_per_chromosome, std::size_t num_chromosomes,
+                        std::size_t* costs) const override {
+            knapsack_.eval_batch(genes, words_per_chromosome, num_chromosomes, costs);
+        }
+    private:
+        const Knapsack& knapsack_;
+    };
+
+    // Reports num_chromosomes chromosomes of num_genes genes processed per iteration as evals/s and genes/s. Operators
+    // whose cost does not depend on the number of genes pass 0 and only get evals/s.
+    void set_throughput(benchmark::State& state, std::size_t num_chromosomes, std::size_t num_genes) {
+        const auto processed = static_cast<double>(state.iterations() * num_chromosomes);
+        state.counters["evals/s"] = benchmark::Counter(processed, benchmark::Counter::kIsRate);
+        if (num_genes != 0) {
+            state.counters["genes/s"] = benchmark::Counter(processed * num_genes, benchmark::Counter::kIsRate);
+        }
+    }
+
+    // Chromosome sizes 10 to 1M
+    void gene_sweep(benchmark::internal::Benchmark* benchmark) {
+        for (std::int64_t num_genes = 10; num_genes <= 1000000; num_genes *= 10) {
+            benchmark->Arg(num_genes);
+        }
+    }
+
+    // Chromosome sizes 10 to 1M for population sizes 20 and 200
+    void population_sweep(benchmark::internal::Benchmark* benchmark) {
+        for (std::int64_t num_genes = 10; num_genes <= 1000000; num_genes *= 10) {
+            for (const std::int64_t pop_size : {20, 200}) {
+                benchmark->Args({num_genes, pop_size});
+            }
+        }
+    }
+
+    void BM_KnapsackEval(benchmark::State& state) {
+        const auto num_genes = static_cast<std::size_t>(state.range(0));
+        const auto knapsack = make_knapsack(num_genes);
+        PackedChromosome chromosome(num_genes);
+        for (std::size_t gene = 0; gene < num_genes; gene += 3) {
+            chromosome.set(gene);
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(knapsack->eval(chromosome.view()));
+        }
+        set_throughput(state, 1, num_genes);
+    }
+    BENCHMARK(BM_KnapsackEval)->Apply(gene_sweep);
+
+    // A random knapsack with num_dims resources whose optimum holds about a third of the items
+    std::unique_ptr<MultiKnapsack> make_multi_knapsack(std::size_t num_genes, std::size_t num_dims) {
+        std::mt19937 eng{42};
+        std::uniform_int_distribution<std::size_t> dist(1, 30);
+        auto knapsack = std::make_unique<MultiKnapsack>(num_genes, std::vector<std::size_t>(num_dims, num_genes * 5),
+                                                        num_genes);
+        std::vector<std::size_t> weights(num_dims);
+        for (std::size_t gene = 0; gene < num_genes; ++gene) {
+            std::generate(std::begin(weights), std::end(weights), [&]() { return dist(eng); });
+            knapsack->add_config(dist(eng), weights);
+        }
+        return knapsack;
+    }
+
+    // Chromosome sizes 10 to 100k for 5 and 20 resource dimensions
+    void dimension_sweep(benchmark::internal::Benchmark* benchmark) {
+        for (std::int64_t num_genes = 10; num_genes <= 100000; num_genes *= 10) {
+            for (const std::int64_t num_dims : {5, 20}) {
+                benchmark->Args({num_genes, num_dims});
+            }
+        }
+    }
+
+    // A feasible chromosome, so every word is added and checked (no early exit)
+    void BM_MultiKnapsackEval(benchmark::State& state) {
+        const auto num_genes = static_cast<std::size_t>(state.range(0));
+        const auto knapsack = make_multi_knapsack(num_genes, static_cast<std::size_t>(state.range(1)));
+        PackedChromosome chromosome(num_genes);
+        for (std::size_t gene = 0; gene < num_genes; gene += 7) {
+            chromosome.set(gene);
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(knapsack->evaluate(chromosome.view()));
+        }
+        set_throughput(state, 1, num_genes);
+    }
+    BENCHMARK(BM_MultiKnapsackEval)->Apply(dimension_sweep);
+
+    // Repairs a chromosome with every item In. Refilling it is not timed.
+    void BM_MultiKnapsackRepair(benchmark::State& state) {
+        const auto num_genes = static_cast<std::size_t>(state.range(0));
+        const auto knapsack = make_multi_knapsack(num_genes, static_cast<std::size_t>(state.range(1)));
+        const MultiKnapsackRepair repair(*knapsack);
+        PackedChromosome chromosome(num_genes);
+        BinaryCostFunction::Totals totals;
+        for (auto _ : state) {
+            state.PauseTiming();
+            std::fill_n(chromosome.data(), chromosome.num_words(), ~packed::Word{0});
+            chromosome.trim();
+            state.ResumeTiming();
+            benchmark::DoNotOptimize(repair.repair(*knapsack, {chromosome.data(), num_genes}, totals));
+        }
+        set_throughput(state, 1, num_genes);
+    }
+    BENCHMARK(BM_MultiKnapsackRepair)->Apply(dimension_sweep);
+
+    // Runs one GA operator per iteration on a population of state.range(1) chromosomes of state.range(0) genes
+    template <typename Op>
+    void run_operator(benchmark::State& state, Op op, bool per_gene = true, bool full_eval = false) {
+        const auto num_genes = static_cast<std::size_t>(state.range(0));
+        const auto knapsack = make_knapsack(num_genes);
+        const FullEvalKnapsack full_eval_knapsack(*knapsack);
+        const auto ga = full_eval ? make_ga(full_eval_knapsack, static_cast<std::size_t>(state.range(1)))
+                                  : make_ga(*knapsack, static_cast<std::size_t>(state.range(1)));
+        for (auto _ : state) {
+            op(*ga);
+        }
+        set_throughput(state, GABenchAccess::population_size(*ga), per_gene ? num_genes : 0);
+    }
+
+    // Selection only draws parent numbers - evals/s counts the children whose parents were drawn
+    void BM_Select(benchmark::State& state) { run_operator(state, GABenchAccess::select, false); }
+    void BM_Cross(benchmark::State& state) { run_operator(state, GABenchAccess::cross); }
+    void BM_Mutate(benchmark::State& state) { run_operator(state, GABenchAccess::mutate); }
+    // Knapsack costs come from the running totals in O(1) per chromosome; the full variant evaluates every gene
+    void BM_CalculateCosts(benchmark::State& state) { run_operator(state, GABenchAccess::calculate_costs, false); }
+    void BM_CalculateCostsFull(benchmark::State& state) { run_operator(state, GABenchAccess::calculate_costs, true, true); }
+    BENCHMARK(BM_Select)->Apply(population_sweep);
+    BENCHMARK(BM_Cross)->Apply(population_sweep);
+    BENCHMARK(BM_Mutate)->Apply(population_sweep);
+    BENCHMARK(BM_CalculateCosts)->Apply(population_sweep);
+    BENCHMARK(BM_CalculateCostsFull)->Apply(population_sweep);
+
+    // Repairs a population in which every chromosome is overfilled. Refilling the population is not timed.
+    void BM_Repair(benchmark::State& state) {
+        const auto num_genes = static_cast<std::size_t>(state.range(0));
+        const auto knapsack = make_knapsack(num_genes);
+        const auto ga = make_ga(*knapsack, static_cast<std::size_t>(state.range(1)));
+        for (auto _ : state) {
+            state.PauseTiming();
+            GABenchAccess::overfill(*ga);
+            state.ResumeTiming();
+            GABenchAccess::repair(*ga);
+        }
+        set_throughput(state, GABenchAccess::population_size(*ga), num_genes);
+    }
+    BENCHMARK(BM_Repair)->Apply(population_sweep);
+
+    // A whole generation through new_population
+    void BM_Generation(benchmark::State& state) {
+        const auto num_genes = static_cast<std::size_t>(state.range(0));
+        const auto knapsack = make_knapsack(num_genes);
+        const auto ga = make_ga(*knapsack, static_cast<std::size_t>(state.range(1)));
+#ifdef GA_COUNT_ALLOCATIONS
+        std::size_t allocations = 0;
+#endif
+        for (auto _ : state) {
+            ga->new_population(1);
+#ifdef GA_COUNT_ALLOCATIONS
+            allocations += ga->loop_allocations();
+#endif
+        }
+        set_throughput(state, GABenchAccess::population_size(*ga), num_genes);
+#ifdef GA_COUNT_ALLOCATIONS
+        state.counters["allocs_per_gen"] = benchmark::Counter(static_cast<double>(allocations),
+                                                              benchmark::Counter::kAvgIterations);
+#endif
+    }
+    BENCHMARK(BM_Generation)->Apply(population_sweep);
+
+    void BM_GreedySolve(benchmark::State& state) {
+        const auto num_genes = static_cast<std::size_t>(state.range(0));
+        const auto knapsack = make_knapsack(num_genes);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(knapsack->greedy_solve());
+        }
+        set_throughput(state, 1, num_genes);
+    }
+    BENCHMARK(BM_GreedySolve)->Apply(gene_sweep);
+
+    // Exhaustive search is only feasible for small instances; evals/s counts the subsets enumerated
+    void BM_BruteForce(benchmark::State& state) {
+        const auto num_genes = static_cast<std::size_t>(state.range(0));
+        const auto knapsack = make_knapsack(num_genes);
+        BruteForce bf;
+        bf.set_cf(knapsack.get());
+        bf.set_mode(static_cast<BruteForce::Mode>(state.range(1)));
+        bf.set_num_threads(1);
+        for (auto _ : state) {
+            bf.solve();
+            benchmark::DoNotOptimize(bf.get_best_cost());
+        }
+        set_throughput(state, std::size_t{1} << num_genes, num_genes);
+    }
+    BENCHMARK(BM_BruteForce)->ArgsProduct({{10, 15, 20}, {static_cast<std::int64_t>(BruteForce::Mode::Batch),
+                                                          static_cast<std::int64_t>(BruteForce::Mode::GrayCode)}})
+                            ->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_MAIN();
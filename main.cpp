@@ -1,24 +1,57 @@
+#include "ParameterSweep.h"
 #include "ProjectTester.h"
+#include "SweepConfig.h"
+#include "Timer.h"
 
+#include <exception>
 #include <iostream>
-#include <fstream>
+#include <random>
 
 
 int main(int argc, char* argv[]) {
 
-    // Testing -> Ideally should not have to recompile program if we
-    // want to alter these parameters
-    constexpr std::size_t num_gens = 1000;
-    constexpr std::size_t population_size = 20;
-    constexpr std::size_t num_elite = 1;
-    constexpr std::size_t tournament_size = 2;
-    constexpr double mutation_rate = 0.2;
-    constexpr std::size_t num_simulations = 1;
+    // The parameters come from the command line and/or a config file (see SweepConfig.h), so sweeps do not need
+    // a recompile
+    SweepConfig config;
+    try {
+        config = SweepConfig::from_args(argc, argv);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << "\n\n";
+        SweepConfig::print_usage(std::cerr, argv[0]);
+        return 1;
+    }
+    if (config.help) {
+        SweepConfig::print_usage(std::cout, argv[0]);
+        return 0;
+    }
 
-    // Instantiate the tester and create/clear the output file
-    ProjectTester tester;
-    tester.set_ga_parameters(population_size, num_elite, tournament_size, mutation_rate);
-    std::string outfile = "best_costs";
-    //tester.solve_random(150, 7500, 150);
-    tester.solve_all(num_gens, num_simulations, outfile);
-}
\ No newline at end of file
+    try {
+        if (config.check) {
+            // Regression check of the knapsack solvers on random instances with every kind of corner case item
+            ProjectTester tester;
+            return tester.check_solvers(300, config.seed.value_or(std::random_device{}())) == 0 ? 0 : 1;
+        }
+        if (config.instances.empty()) {
+            // Instantiate the tester and solve the handout knapsacks with the first value of each parameter
+            ProjectTester tester;
+            tester.set_ga_parameters(config.pop_sizes.front(), config.num_elites.front(), config.t_sizes.front(),
+                                     config.mutation_rates.front());
+            tester.set_seed(config.seed);
+            tester.set_num_workers(config.num_workers);
+            std::string outfile = config.output.empty() ? "best_costs" : config.output;
+            //tester.solve_random(150, 7500, 150);
+            tester.solve_all(config.num_gens.front(), config.num_runs, outfile);
+            return 0;
+        }
+        ParameterSweep sweep(config);
+        std::cout << "Running " << sweep.num_jobs() << " runs over " << sweep.num_points() << " parameter combinations.\n";
+        Timer timer;
+        sweep.run();
+        timer.time("Sweep time: ");
+        sweep.write_results(config.output.empty() ? "sweep.csv" : config.output);
+        sweep.print_summary(std::cout);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << '\n';
+        return 1;
+    }
+}